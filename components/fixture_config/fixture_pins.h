@@ -42,6 +42,23 @@
 #define PIN_SIM_STOP    GPIO_NUM_5      /* Pogo -> STOP pad    (active LOW) */
 #define PIN_LOAD_SENSE  GPIO_NUM_6      /* Opto-isolated load sense input   */
 
+/*
+ * Dual-DUT Mode (CONFIG_LATCHPAC_DUAL_DUT)
+ *
+ * The fixture chassis fits two DUT nests.  Slot B gets its own pogo
+ * and SWD pin set; the SWD engine is shared and switched between
+ * ports at transaction-sequence granularity (see swd_select_port).
+ * Direct-wire SWD only -- the opto-isolated harness is single-slot.
+ */
+#ifdef CONFIG_LATCHPAC_DUAL_DUT
+#define PIN_SWD_CLK_B    GPIO_NUM_13    /* Slot B Tag-Connect Pin 2 */
+#define PIN_SWD_IO_B     GPIO_NUM_14    /* Slot B Tag-Connect Pin 4 */
+#define PIN_SWD_NRST_B   GPIO_NUM_21    /* Slot B Tag-Connect Pin 5 */
+#define PIN_SIM_START_B  GPIO_NUM_7     /* Slot B pogo -> START pad  */
+#define PIN_SIM_STOP_B   GPIO_NUM_8     /* Slot B pogo -> STOP pad   */
+#define PIN_LOAD_SENSE_B GPIO_NUM_9     /* Slot B load sense input   */
+#endif
+
 /* ---------- Fixture UI (Operator Panel) ---------- */
 #define PIN_START_BUTTON GPIO_NUM_0     /* Boot button -- operator "GO"      */
 #define PIN_STATUS_LED_G GPIO_NUM_10    /* Green LED -- PASS                 */
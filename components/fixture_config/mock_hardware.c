@@ -7,6 +7,12 @@
  *
  * v2 adds mock SWD register / memory stubs returning canned responses.
  *
+ * v4 adds a configurable fault-injection and timing model: the load
+ * settles after a programmable delay instead of instantly, and SWD
+ * stubs roll against injected WAIT/FAULT/parity/wrong-IDCODE rates
+ * from a seedable LCG, so the sequencer's retry and adaptive-settle
+ * paths run (deterministically) without a fixture.
+ *
  * Latch behaviour model (active-low pogo pins):
  *   SIM_START=0  + SIM_STOP=0  -> load turns ON   (both pressed)
  *   SIM_START=1  + SIM_STOP=1  -> load turns OFF   (both released)
@@ -19,16 +25,88 @@
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include "driver/gpio.h"
+#include "esp_timer.h"
 #include "mock_hardware.h"
 
+/* A plausible wrong part on the pogo pins (STM32F1-era DPIDR) */
+#define MOCK_WRONG_IDCODE       0x1BA01477u
+
+/* Mirrors SWD_MAX_RETRIES in swd_host.c so mock attempt counts match
+ * what the real engine would report */
+#define MOCK_VERIFY_ATTEMPTS    3
+
 static float simulated_voltage = 0.0f;
 static bool  latched           = false;
 
+/* ------------------------------------------------------------------ */
+/*  v4: Fault model state                                               */
+/* ------------------------------------------------------------------ */
+
+static mock_fault_profile_t s_profile;      /* All-zero = clean model */
+static uint32_t             s_lcg = 0x4C503342u;    /* "LP3B" */
+
+static float   s_voltage_target   = 0.0f;
+static int64_t s_settle_until_us  = 0;
+
+void mock_fault_configure(const mock_fault_profile_t *profile)
+{
+    if (profile != NULL) {
+        s_profile = *profile;
+    } else {
+        memset(&s_profile, 0, sizeof(s_profile));
+    }
+}
+
+void mock_fault_seed(uint32_t seed)
+{
+    s_lcg = seed;
+}
+
+/* Numerical Recipes LCG; top bits are the usable ones */
+static uint32_t mock_rand(void)
+{
+    s_lcg = s_lcg * 1664525u + 1013904223u;
+    return s_lcg >> 16;
+}
+
+static bool fault_roll(uint8_t rate_pct)
+{
+    return rate_pct > 0 && (mock_rand() % 100u) < rate_pct;
+}
+
+/* Transient wire errors shared by every SWD stub.  Roll order matches
+ * how the real wire fails: WAIT (target busy) is the common case,
+ * FAULT and parity are rarer. */
+static mock_swd_status_t fault_roll_transaction(void)
+{
+    if (fault_roll(s_profile.swd_wait_pct))   return MOCK_SWD_ACK_WAIT;
+    if (fault_roll(s_profile.swd_fault_pct))  return MOCK_SWD_ACK_FAULT;
+    if (fault_roll(s_profile.swd_parity_pct)) return MOCK_SWD_PARITY_ERROR;
+    return MOCK_SWD_OK;
+}
+
 /* ------------------------------------------------------------------ */
 /*  v1 API                                                              */
 /* ------------------------------------------------------------------ */
 
+/* Move the sense voltage toward target: instantly in the clean model,
+ * after settle_delay_ms when the timing model is configured. */
+static void mock_settle_toward(float target)
+{
+    if (target == s_voltage_target) {
+        return;     /* No latch edge */
+    }
+    s_voltage_target = target;
+    if (s_profile.settle_delay_ms == 0) {
+        simulated_voltage = target;
+    } else {
+        s_settle_until_us = esp_timer_get_time() +
+                            (int64_t)s_profile.settle_delay_ms * 1000;
+    }
+}
+
 void mock_update_simulation(void)
 {
     int start_level = gpio_get_level(PIN_SIM_START);
@@ -36,24 +114,30 @@ void mock_update_simulation(void)
 
     if (start_level == 0 && stop_level == 0) {
         latched = true;
-        simulated_voltage = 3.3f;
+        mock_settle_toward(3.3f);
     } else if (start_level == 1 && stop_level == 1) {
         latched = false;
-        simulated_voltage = 0.0f;
+        mock_settle_toward(0.0f);
     } else if (stop_level == 0 && start_level == 1) {
         latched = false;
-        simulated_voltage = 0.0f;
+        mock_settle_toward(0.0f);
     }
 }
 
 float mock_read_voltage(void)
 {
+    if (simulated_voltage != s_voltage_target &&
+        esp_timer_get_time() >= s_settle_until_us) {
+        simulated_voltage = s_voltage_target;
+    }
     return simulated_voltage;
 }
 
 bool mock_swd_verify(void)
 {
-    return true;
+    uint32_t idcode = 0;
+    return mock_swd_verify_detailed(&idcode, NULL) == MOCK_SWD_OK &&
+           idcode == SWD_IDCODE_STM32G030;
 }
 
 /* ------------------------------------------------------------------ */
@@ -62,9 +146,16 @@ bool mock_swd_verify(void)
 
 mock_swd_status_t mock_swd_read_dp(uint8_t addr, uint32_t *value)
 {
+    mock_swd_status_t st = fault_roll_transaction();
+    if (st != MOCK_SWD_OK) {
+        *value = 0;
+        return st;
+    }
+
     switch (addr) {
     case 0x00:  /* DPIDR */
-        *value = SWD_IDCODE_STM32G030;
+        *value = fault_roll(s_profile.swd_wrong_id_pct) ? MOCK_WRONG_IDCODE
+                                                        : SWD_IDCODE_STM32G030;
         break;
     case 0x04:  /* CTRL/STAT -- report powerup ACK bits set */
         *value = (1u << 29) | (1u << 31);  /* CDBGPWRUPACK | CSYSPWRUPACK */
@@ -83,11 +174,17 @@ mock_swd_status_t mock_swd_write_dp(uint8_t addr, uint32_t value)
 {
     (void)addr;
     (void)value;
-    return MOCK_SWD_OK;
+    return fault_roll_transaction();
 }
 
 mock_swd_status_t mock_swd_read_ap(uint8_t addr, uint32_t *value)
 {
+    mock_swd_status_t st = fault_roll_transaction();
+    if (st != MOCK_SWD_OK) {
+        *value = 0;
+        return st;
+    }
+
     switch (addr) {
     case 0x0C:  /* DRW -- mock memory read */
         *value = 0xDEADBEEF;
@@ -103,11 +200,15 @@ mock_swd_status_t mock_swd_write_ap(uint8_t addr, uint32_t value)
 {
     (void)addr;
     (void)value;
-    return MOCK_SWD_OK;
+    return fault_roll_transaction();
 }
 
 mock_swd_status_t mock_swd_powerup_debug(void)
 {
+    mock_swd_status_t st = fault_roll_transaction();
+    if (st != MOCK_SWD_OK) {
+        return st;
+    }
     printf("INFO, SWD debug domain active -- AP IDR=0x04770031 (mock)\n");
     return MOCK_SWD_OK;
 }
@@ -115,18 +216,59 @@ mock_swd_status_t mock_swd_powerup_debug(void)
 mock_swd_status_t mock_swd_mem_read32(uint32_t addr, uint32_t *value)
 {
     (void)addr;
+    mock_swd_status_t st = fault_roll_transaction();
+    if (st != MOCK_SWD_OK) {
+        *value = 0;
+        return st;
+    }
     *value = 0xDEADBEEF;
     return MOCK_SWD_OK;
 }
 
 mock_swd_status_t mock_swd_integrity_test(int iterations, int *pass_count, int *fail_count)
 {
-    if (pass_count) *pass_count = iterations;
-    if (fail_count) *fail_count = 0;
-    printf("INFO, SWD integrity test: %d/%d passed (mock)\n", iterations, iterations);
+    int pass = 0;
+    for (int i = 0; i < iterations; i++) {
+        uint32_t idcode = 0;
+        if (mock_swd_verify_detailed(&idcode, NULL) == MOCK_SWD_OK &&
+            idcode == SWD_IDCODE_STM32G030) {
+            pass++;
+        }
+    }
+    if (pass_count) *pass_count = pass;
+    if (fail_count) *fail_count = iterations - pass;
+    printf("INFO, SWD integrity test: %d/%d passed (mock)\n", pass, iterations);
     return MOCK_SWD_OK;
 }
 
+/* ------------------------------------------------------------------ */
+/*  v4 API: Detailed verify with injected faults                        */
+/* ------------------------------------------------------------------ */
+
+mock_swd_status_t mock_swd_verify_detailed(uint32_t *idcode, int *attempts)
+{
+    mock_swd_status_t last = MOCK_SWD_ERROR;
+
+    for (int attempt = 1; attempt <= MOCK_VERIFY_ATTEMPTS; attempt++) {
+        if (attempts) *attempts = attempt;
+
+        last = fault_roll_transaction();
+        if (last != MOCK_SWD_OK) {
+            continue;   /* Transient: the real engine retries these */
+        }
+        if (fault_roll(s_profile.swd_wrong_id_pct)) {
+            /* Bus worked; the wrong part answered.  No retry helps. */
+            if (idcode) *idcode = MOCK_WRONG_IDCODE;
+            return MOCK_SWD_OK;
+        }
+        if (idcode) *idcode = SWD_IDCODE_STM32G030;
+        return MOCK_SWD_OK;
+    }
+
+    if (idcode) *idcode = 0;
+    return last;
+}
+
 #else /* !MOCK_HARDWARE_MODE -- production build */
 
 typedef int _mock_hardware_production_stub;
@@ -9,7 +9,7 @@
 #include <stdint.h>
 
 /* ===================================================================
- * LatchPac Validator 3000 -- Mock Hardware (v2/v3)
+ * LatchPac Validator 3000 -- Mock Hardware (v2/v3/v4)
  *
  * v1: mock_update_simulation, mock_read_voltage, mock_swd_verify
  * v2: mock_swd_read_dp, mock_swd_write_dp, mock_swd_read_ap,
@@ -18,6 +18,10 @@
  * v3: No new mock stubs needed -- swd_safe_state(), swd_abort_recovery(),
  *     and swd_verify_target_detailed() are provided by swd_host.c (always
  *     compiled) and guarded by #ifndef MOCK_HARDWARE_MODE at call sites.
+ * v4: Fault-injection and timing model -- programmable load settle
+ *     delay, injectable SWD WAIT/FAULT/parity/wrong-IDCODE rates, and
+ *     deterministic seeding, so retry, timeout and adaptive-settle
+ *     paths can be exercised (and cycle time measured) off-fixture.
  *
  * NOTE: swd_status_t is forward-declared here to avoid a circular
  * dependency between fixture_config and swd_programmer.  The full
@@ -55,6 +59,45 @@ mock_swd_status_t mock_swd_powerup_debug(void);
 mock_swd_status_t mock_swd_mem_read32(uint32_t addr, uint32_t *value);
 mock_swd_status_t mock_swd_integrity_test(int iterations, int *pass_count, int *fail_count);
 
+/* ------------------------------------------------------------------ */
+/*  v4 API: Fault injection and timing model                            */
+/* ------------------------------------------------------------------ */
+
+/**
+ * @brief Mock fault profile.  All-zero (the default) is the clean
+ *        model: instant settle, every SWD transaction succeeds.
+ *
+ * Rates are per-roll percentages (0..100).  The wrong-IDCODE roll
+ * only applies where an IDCODE is produced (DPIDR reads, verify).
+ */
+typedef struct {
+    uint32_t settle_delay_ms;   /* Simulated load settle after a latch edge */
+    uint8_t  swd_wait_pct;      /* Per-transaction WAIT probability         */
+    uint8_t  swd_fault_pct;     /* Per-transaction FAULT probability        */
+    uint8_t  swd_parity_pct;    /* Per-transaction parity-error probability */
+    uint8_t  swd_wrong_id_pct;  /* Wrong-DPIDR probability                  */
+} mock_fault_profile_t;
+
+/**
+ * @brief Install a fault profile (copied).  NULL restores the clean
+ *        default model.
+ */
+void mock_fault_configure(const mock_fault_profile_t *profile);
+
+/**
+ * @brief Re-seed the fault-roll PRNG (a fixed LCG), making injected
+ *        fault sequences reproducible run to run.
+ */
+void mock_fault_seed(uint32_t seed);
+
+/**
+ * @brief Mock counterpart of swd_verify_target_detailed(): retries
+ *        through injected transient errors, reports the IDCODE read
+ *        and the attempt count.  Status values map 1:1 onto
+ *        swd_status_t.
+ */
+mock_swd_status_t mock_swd_verify_detailed(uint32_t *idcode, int *attempts);
+
 #endif /* MOCK_HARDWARE_MODE */
 
 #endif /* MOCK_HARDWARE_H */
@@ -2,6 +2,7 @@
 #define CSV_LOGGER_H
 
 #include <stdint.h>
+#include <stdbool.h>
 
 /* ===================================================================
  * LatchPac Validator 3000 -- CSV Result Logger (v2)
@@ -53,7 +54,77 @@ void log_header_v2(void);
 
 /**
  * @brief Print one v2 CSV result line to serial.
+ *        Emits CSV or a binary frame depending on log_set_format().
  */
 void log_result_v2(const log_entry_t *entry);
 
+/* ------------------------------------------------------------------ */
+/*  v3 API: Binary framed wire format                                   */
+/* ------------------------------------------------------------------ */
+
+/**
+ * @brief Result record wire formats.
+ */
+typedef enum {
+    LOG_FORMAT_CSV = 0,     /* Human-readable CSV lines (compatibility) */
+    LOG_FORMAT_BINARY       /* Framed fixed-layout records              */
+} log_format_t;
+
+/**
+ * @brief Binary result record as it appears on the wire.
+ *
+ * Fixed layout mirroring log_entry_t, framed with magic, an
+ * incrementing sequence number, and a trailing CRC-16/CCITT over all
+ * preceding bytes so the host decoder can resync and detect
+ * corruption.  INFO text lines still pass through as plain ASCII;
+ * the decoder (tools/decode_log.py) scans for the magic.
+ */
+typedef struct __attribute__((packed)) {
+    uint16_t magic;             /* LOG_BIN_MAGIC (0x504C, "LP")      */
+    uint16_t seq;               /* Incrementing record sequence       */
+    int64_t  timestamp_ms;      /* esp_timer time at emission         */
+    int32_t  unit_id;
+    char     status[20];        /* NUL-padded result string           */
+    float    voltage;
+    uint32_t swd_idcode;
+    int32_t  swd_attempts;
+    uint32_t test_duration_ms;
+    char     fw_version[16];    /* NUL-padded version string          */
+    uint16_t crc;               /* CRC-16/CCITT of all bytes above    */
+} log_record_bin_t;
+
+#define LOG_BIN_MAGIC   0x504Cu
+
+/**
+ * @brief Select the result record wire format (default: CSV).
+ */
+void log_set_format(log_format_t format);
+
+/**
+ * @brief Currently selected wire format.
+ */
+log_format_t log_get_format(void);
+
+/**
+ * @brief Fill a binary record from a log entry, including the CRC.
+ *
+ * Shared by the serial binary emitter and the persistent result store
+ * (result_store.h) so both produce identical frames.
+ *
+ * @param entry        Source entry.
+ * @param seq          Sequence number to stamp into the record.
+ * @param timestamp_ms Timestamp to stamp (test time -- callers that
+ *                     defer building pass the time of capture).
+ * @param rec          Record to fill.
+ */
+void log_record_build(const log_entry_t *entry, uint16_t seq,
+                      int64_t timestamp_ms, log_record_bin_t *rec);
+
+/**
+ * @brief Validate a record's magic and trailing CRC-16.
+ *
+ * @return true if the record is well-formed.
+ */
+bool log_record_check(const log_record_bin_t *rec);
+
 #endif /* CSV_LOGGER_H */
@@ -0,0 +1,101 @@
+#ifndef LOG_ASYNC_H
+#define LOG_ASYNC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ===================================================================
+ * LatchPac Validator 3000 -- Asynchronous Log Channel (v1)
+ *
+ * Synchronous printf() to the console UART stalls the test task for
+ * the full line time at the console baud rate.  This layer enqueues
+ * formatted lines into a static ring of fixed-size slots; a
+ * low-priority drain task pushes them out through the UART driver's
+ * interrupt-driven TX path.  When the ring saturates, lines are
+ * dropped and counted rather than blocking the producer.
+ *
+ * Until log_async_init() has run (or if it fails), log_info() falls
+ * back to plain printf(), so boot-time logging is unaffected.
+ * =================================================================== */
+
+/**
+ * @brief Install the UART driver and start the drain task.
+ *
+ * Call once at boot.  On failure the async channel stays inactive
+ * and all logging remains synchronous.
+ */
+void log_async_init(void);
+
+/**
+ * @brief Whether the async channel is up (drain task running).
+ */
+bool log_async_active(void);
+
+/**
+ * @brief printf-style INFO-channel logging.
+ *
+ * Formats into a ring slot and returns immediately; never blocks on
+ * the UART.  Lines longer than a slot are truncated.
+ */
+void log_info(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief Enqueue an already-formatted line (used by the CSV logger).
+ * @param line  NUL-terminated text including trailing newline.
+ */
+void log_async_write(const char *line);
+
+/**
+ * @brief Enqueue a raw byte block (binary framed records).
+ *        Blocks longer than a ring slot are dropped and counted.
+ */
+void log_async_write_bytes(const void *data, int len);
+
+/**
+ * @brief Number of lines dropped because the ring was full.
+ */
+uint32_t log_async_dropped(void);
+
+/* ------------------------------------------------------------------ */
+/*  v2 API: Zero-copy result entries                                    */
+/* ------------------------------------------------------------------ */
+
+/**
+ * @brief Raw result entry: integer fields plus pointers to static
+ *        strings.
+ *
+ * Enqueueing one is a struct copy into a ring slot -- no formatting,
+ * no heap, no string copies on the test-task side.  The drain task
+ * renders it to a CSV line (integer-only conversions, voltage from
+ * millivolts) or a framed binary record on its own time.
+ *
+ * Both string pointers MUST reference static storage (result strings
+ * from test_result_to_string(), the app-descriptor version): the
+ * entry outlives the caller's stack frame.
+ */
+typedef struct {
+    int64_t     timestamp_ms;   /* Test-time stamp (not drain time)  */
+    int32_t     unit_id;
+    const char *status;
+    int32_t     voltage_mv;
+    uint32_t    swd_idcode;
+    int32_t     swd_attempts;
+    uint32_t    duration_ms;
+    const char *fw_version;
+    uint16_t    bin_seq;        /* Binary frame sequence number      */
+    bool        binary;         /* Render as a framed binary record  */
+} log_raw_result_t;
+
+/**
+ * @brief Post a raw result entry for deferred rendering.
+ *
+ * Never blocks: if the ring is full the entry is dropped and counted
+ * like any other saturated line.
+ *
+ * @return true if the channel handled it (queued or counted as
+ *         dropped); false if the async channel is down, in which case
+ *         the caller should format synchronously.
+ */
+bool log_async_post_result(const log_raw_result_t *raw);
+
+#endif /* LOG_ASYNC_H */
@@ -0,0 +1,66 @@
+#ifndef RESULT_STORE_H
+#define RESULT_STORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "csv_logger.h"
+
+/* ===================================================================
+ * LatchPac Validator 3000 -- Persistent Result Store (v1)
+ *
+ * On-flash ring of fixed-size result records so test history survives
+ * power loss and is recoverable when the line PC misses serial output.
+ * Records are the same framed log_record_bin_t the binary wire format
+ * uses (magic + sequence + CRC-16), appended to a dedicated raw
+ * partition ("results" in partitions.csv).
+ *
+ * Unlike the per-test NVS commit pattern, appends are buffered in RAM
+ * and flushed in batches -- sequential flash programs amortize to
+ * microseconds per record, and a whole 4 KB sector of history is
+ * reclaimed at a time once the ring wraps (inherent wear levelling:
+ * every sector is erased equally often).  A crash costs at most the
+ * buffered batch; the serial CSV line for each unit has already gone
+ * out by then.
+ * =================================================================== */
+
+/** Partition label the store mounts (see partitions.csv). */
+#define RESULT_STORE_PARTITION  "results"
+
+/**
+ * @brief Mount the result ring and locate the write position.
+ *
+ * Scans the partition for the highest record sequence number and
+ * resumes appending after it.  All other calls are no-ops until this
+ * succeeds, so callers need not guard them.
+ *
+ * @return true if the partition was found and scanned.
+ */
+bool result_store_init(void);
+
+/**
+ * @brief Queue one result for persistence.
+ *
+ * Buffered in RAM; written to flash once RESULT_STORE_BATCH records
+ * accumulate or result_store_flush() is called.
+ */
+void result_store_append(const log_entry_t *entry);
+
+/**
+ * @brief Write any buffered records to flash now.
+ *
+ * Called on fixture state changes (test abort, operator opening the
+ * lid) and from the shutdown handler.
+ */
+void result_store_flush(void);
+
+/**
+ * @brief Replay the stored backlog to serial, oldest record first.
+ *
+ * Emits a v2 CSV header followed by one LOG line per valid record;
+ * corrupt or erased slots are skipped.  Intended as a console command.
+ *
+ * @return Number of records dumped.
+ */
+int result_store_dump(void);
+
+#endif /* RESULT_STORE_H */
@@ -12,9 +12,29 @@
  * =================================================================== */
 
 #include <stdio.h>
+#include <string.h>
 #include <inttypes.h>
 #include "esp_timer.h"
 #include "csv_logger.h"
+#include "log_async.h"
+
+static log_format_t s_format = LOG_FORMAT_CSV;
+static uint16_t     s_bin_seq = 0;
+
+/* CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) -- matches
+ * tools/decode_log.py */
+static uint16_t crc16_ccitt(const uint8_t *data, size_t len)
+{
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021)
+                                 : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
 
 /* ------------------------------------------------------------------ */
 /*  v1 API                                                              */
@@ -42,17 +62,99 @@ void log_header_v2(void)
            "SWD_IDCODE, SWD_Attempts, Test_Duration_ms, FW_Version\n");
 }
 
+void log_record_build(const log_entry_t *entry, uint16_t seq,
+                      int64_t timestamp_ms, log_record_bin_t *rec)
+{
+    memset(rec, 0, sizeof(*rec));
+
+    rec->magic            = LOG_BIN_MAGIC;
+    rec->seq              = seq;
+    rec->timestamp_ms     = timestamp_ms;
+    rec->unit_id          = entry->unit_id;
+    strncpy(rec->status, entry->status ? entry->status : "",
+            sizeof(rec->status) - 1);
+    rec->voltage          = entry->voltage;
+    rec->swd_idcode       = entry->swd_idcode;
+    rec->swd_attempts     = entry->swd_attempts;
+    rec->test_duration_ms = entry->test_duration_ms;
+    strncpy(rec->fw_version, entry->fw_version ? entry->fw_version : "unknown",
+            sizeof(rec->fw_version) - 1);
+    rec->crc = crc16_ccitt((const uint8_t *)rec,
+                           sizeof(*rec) - sizeof(rec->crc));
+}
+
+bool log_record_check(const log_record_bin_t *rec)
+{
+    return rec->magic == LOG_BIN_MAGIC &&
+           rec->crc == crc16_ccitt((const uint8_t *)rec,
+                                   sizeof(*rec) - sizeof(rec->crc));
+}
+
+/* Build and emit one framed binary record (synchronous fallback) */
+static void log_result_binary(const log_entry_t *entry)
+{
+    log_record_bin_t rec;
+    log_record_build(entry, s_bin_seq++,
+                     (int64_t)(esp_timer_get_time() / 1000), &rec);
+    log_async_write_bytes(&rec, sizeof(rec));
+}
+
+void log_set_format(log_format_t format)
+{
+    s_format = format;
+}
+
+log_format_t log_get_format(void)
+{
+    return s_format;
+}
+
 void log_result_v2(const log_entry_t *entry)
 {
+    /* Fast path: post the raw integer fields to the async ring and let
+     * the drain task do the formatting (%f, %lX, strlen of the status
+     * string all move off the test task).  One float-to-millivolt
+     * conversion is the only arithmetic done here. */
+    log_raw_result_t raw = {
+        .timestamp_ms = (int64_t)(esp_timer_get_time() / 1000),
+        .unit_id      = entry->unit_id,
+        .status       = entry->status ? entry->status : "",
+        .voltage_mv   = (int32_t)(entry->voltage * 1000.0f + 0.5f),
+        .swd_idcode   = entry->swd_idcode,
+        .swd_attempts = entry->swd_attempts,
+        .duration_ms  = entry->test_duration_ms,
+        .fw_version   = entry->fw_version ? entry->fw_version : "unknown",
+        .bin_seq      = s_bin_seq,
+        .binary       = (s_format == LOG_FORMAT_BINARY),
+    };
+    if (log_async_post_result(&raw)) {
+        if (raw.binary) {
+            s_bin_seq++;
+        }
+        return;
+    }
+
+    /* Async channel down (boot, or init failed): format here. */
+    if (s_format == LOG_FORMAT_BINARY) {
+        log_result_binary(entry);
+        return;
+    }
+
     int64_t timestamp_ms = (int64_t)(esp_timer_get_time() / 1000);
+    char line[160];
+
+    snprintf(line, sizeof(line),
+             "LOG, %" PRId64 ", %03d, %s, %.2f, 0x%08lX, %d, %lu, %s\n",
+             timestamp_ms,
+             entry->unit_id,
+             entry->status,
+             entry->voltage,
+             (unsigned long)entry->swd_idcode,
+             entry->swd_attempts,
+             (unsigned long)entry->test_duration_ms,
+             entry->fw_version ? entry->fw_version : "unknown");
 
-    printf("LOG, %" PRId64 ", %03d, %s, %.2f, 0x%08lX, %d, %lu, %s\n",
-           timestamp_ms,
-           entry->unit_id,
-           entry->status,
-           entry->voltage,
-           (unsigned long)entry->swd_idcode,
-           entry->swd_attempts,
-           (unsigned long)entry->test_duration_ms,
-           entry->fw_version ? entry->fw_version : "unknown");
+    /* Never blocks the test task: enqueued for the drain task when
+     * the async channel is up, plain stdout otherwise. */
+    log_async_write(line);
 }
@@ -0,0 +1,277 @@
+/* ===================================================================
+ * LatchPac Validator 3000 -- Asynchronous Log Channel (v1)
+ *
+ * Static ring of fixed-size line slots drained by a low-priority
+ * task through the UART driver (interrupt-driven TX, so the drain
+ * task itself only blocks when the driver's TX ring is full).
+ *
+ * Producers run under a spinlock for a dozen stores plus a memcpy;
+ * they never touch the UART.  Saturation drops the line and bumps a
+ * counter which the drain task reports when it changes.
+ *
+ * v2 adds:
+ *   - Zero-copy result entries: log_async_post_result() copies a
+ *     log_raw_result_t of integer fields into a slot tagged RESULT;
+ *     the drain task renders it to CSV or a binary frame.  The %f and
+ *     %lX conversions (and the strlen behind every %s) move from the
+ *     test task to drain time.
+ * =================================================================== */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/uart.h"
+
+#include "csv_logger.h"     /* Deferred rendering of result entries */
+#include "log_async.h"
+
+#define LOG_SLOT_BYTES      160     /* Longest CSV/INFO line + margin   */
+#define LOG_SLOT_COUNT      32      /* ~5 KB static ring                */
+#define LOG_UART            UART_NUM_0
+#define LOG_UART_TX_BUF     4096    /* Driver TX ring (copy-and-return) */
+#define LOG_UART_RX_BUF     256
+#define DRAIN_TASK_PRIO     (tskIDLE_PRIORITY + 1)
+#define DRAIN_IDLE_MS       20
+
+/* What a slot holds: preformatted text, or a raw result entry that
+ * the drain task renders on its own time. */
+#define SLOT_KIND_TEXT      0
+#define SLOT_KIND_RESULT    1
+
+_Static_assert(sizeof(log_raw_result_t) <= LOG_SLOT_BYTES,
+               "raw result entry must fit in a ring slot");
+
+static char              s_slots[LOG_SLOT_COUNT][LOG_SLOT_BYTES];
+static uint8_t           s_slot_len[LOG_SLOT_COUNT];
+static uint8_t           s_slot_kind[LOG_SLOT_COUNT];
+static volatile int      s_head = 0;    /* Next slot to fill  */
+static volatile int      s_tail = 0;    /* Next slot to drain */
+static volatile uint32_t s_dropped = 0;
+static bool              s_active = false;
+static portMUX_TYPE      s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/* ------------------------------------------------------------------ */
+/*  Producer side                                                       */
+/* ------------------------------------------------------------------ */
+
+static void log_enqueue(const char *buf, int len)
+{
+    portENTER_CRITICAL(&s_lock);
+    int next = (s_head + 1) % LOG_SLOT_COUNT;
+    if (next == s_tail) {
+        s_dropped++;
+        portEXIT_CRITICAL(&s_lock);
+        return;
+    }
+    memcpy(s_slots[s_head], buf, len);
+    s_slot_len[s_head] = (uint8_t)len;
+    s_slot_kind[s_head] = SLOT_KIND_TEXT;
+    s_head = next;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+bool log_async_post_result(const log_raw_result_t *raw)
+{
+    if (!s_active) {
+        return false;   /* Caller formats synchronously */
+    }
+    portENTER_CRITICAL(&s_lock);
+    int next = (s_head + 1) % LOG_SLOT_COUNT;
+    if (next == s_tail) {
+        s_dropped++;    /* Saturation policy: drop, never block */
+        portEXIT_CRITICAL(&s_lock);
+        return true;
+    }
+    memcpy(s_slots[s_head], raw, sizeof(*raw));
+    s_slot_len[s_head] = (uint8_t)sizeof(*raw);
+    s_slot_kind[s_head] = SLOT_KIND_RESULT;
+    s_head = next;
+    portEXIT_CRITICAL(&s_lock);
+    return true;
+}
+
+void log_async_write(const char *line)
+{
+    if (!s_active) {
+        fputs(line, stdout);
+        return;
+    }
+    int len = (int)strlen(line);
+    if (len >= LOG_SLOT_BYTES) {
+        len = LOG_SLOT_BYTES - 1;
+    }
+    log_enqueue(line, len);
+}
+
+void log_async_write_bytes(const void *data, int len)
+{
+    if (len <= 0) {
+        return;
+    }
+    if (!s_active) {
+        fwrite(data, 1, len, stdout);
+        fflush(stdout);
+        return;
+    }
+    if (len >= LOG_SLOT_BYTES) {
+        /* A binary record must go out intact or not at all */
+        s_dropped++;
+        return;
+    }
+    log_enqueue(data, len);
+}
+
+void log_info(const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+
+    if (!s_active) {
+        vprintf(fmt, ap);
+        va_end(ap);
+        return;
+    }
+
+    char buf[LOG_SLOT_BYTES];
+    int len = vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+
+    if (len <= 0) {
+        return;
+    }
+    if (len >= LOG_SLOT_BYTES) {
+        len = LOG_SLOT_BYTES - 1;   /* Truncated */
+    }
+    log_enqueue(buf, len);
+}
+
+uint32_t log_async_dropped(void)
+{
+    return s_dropped;
+}
+
+bool log_async_active(void)
+{
+    return s_active;
+}
+
+/* ------------------------------------------------------------------ */
+/*  Drain task                                                          */
+/* ------------------------------------------------------------------ */
+
+/* Render a deferred result entry into out.  Integer-only CSV: the
+ * voltage prints from millivolts with centivolt rounding, so the line
+ * matches what the synchronous path produced from the float. */
+static int log_render_result(const log_raw_result_t *raw, char *out, int cap)
+{
+    if (raw->binary) {
+        log_entry_t entry = {
+            .unit_id          = raw->unit_id,
+            .status           = raw->status,
+            .voltage          = (float)raw->voltage_mv / 1000.0f,
+            .swd_idcode       = raw->swd_idcode,
+            .swd_attempts     = raw->swd_attempts,
+            .test_duration_ms = raw->duration_ms,
+            .fw_version       = raw->fw_version,
+        };
+        log_record_bin_t rec;
+        log_record_build(&entry, raw->bin_seq, raw->timestamp_ms, &rec);
+        memcpy(out, &rec, sizeof(rec));
+        return (int)sizeof(rec);
+    }
+
+    /* Round to centivolts first so the carry propagates into the
+     * volts digit (3995 mV -> "4.00", not "3.100") */
+    int cv = (raw->voltage_mv + 5) / 10;
+    int len = snprintf(out, cap,
+                       "LOG, %" PRId64 ", %03d, %s, %d.%02d, 0x%08lX, %d, %lu, %s\n",
+                       raw->timestamp_ms,
+                       (int)raw->unit_id,
+                       raw->status,
+                       cv / 100,
+                       cv % 100,
+                       (unsigned long)raw->swd_idcode,
+                       (int)raw->swd_attempts,
+                       (unsigned long)raw->duration_ms,
+                       raw->fw_version);
+    if (len < 0) {
+        len = 0;
+    } else if (len >= cap) {
+        len = cap - 1;      /* Truncated */
+    }
+    return len;
+}
+
+static void log_drain_task(void *arg)
+{
+    (void)arg;
+    uint32_t reported_drops = 0;
+
+    while (1) {
+        bool wrote = false;
+
+        while (s_tail != s_head) {
+            int t = s_tail;
+            if (s_slot_kind[t] == SLOT_KIND_RESULT) {
+                log_raw_result_t raw;
+                memcpy(&raw, s_slots[t], sizeof(raw));
+                char rendered[LOG_SLOT_BYTES];
+                int len = log_render_result(&raw, rendered, sizeof(rendered));
+                uart_write_bytes(LOG_UART, rendered, len);
+            } else {
+                uart_write_bytes(LOG_UART, s_slots[t], s_slot_len[t]);
+            }
+            portENTER_CRITICAL(&s_lock);
+            s_tail = (t + 1) % LOG_SLOT_COUNT;
+            portEXIT_CRITICAL(&s_lock);
+            wrote = true;
+        }
+
+        uint32_t drops = s_dropped;
+        if (drops != reported_drops) {
+            char msg[64];
+            int len = snprintf(msg, sizeof(msg),
+                               "INFO, log ring saturated -- %lu lines dropped\n",
+                               (unsigned long)drops);
+            uart_write_bytes(LOG_UART, msg, len);
+            reported_drops = drops;
+        }
+
+        if (!wrote) {
+            vTaskDelay(pdMS_TO_TICKS(DRAIN_IDLE_MS));
+        }
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/*  Init                                                                */
+/* ------------------------------------------------------------------ */
+
+void log_async_init(void)
+{
+    if (s_active) {
+        return;
+    }
+
+    esp_err_t err = uart_driver_install(LOG_UART, LOG_UART_RX_BUF,
+                                        LOG_UART_TX_BUF, 0, NULL, 0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        printf("INFO, log UART driver install failed (0x%x) -- staying synchronous\n",
+               err);
+        return;
+    }
+
+    if (xTaskCreate(log_drain_task, "log_drain", 3072, NULL,
+                    DRAIN_TASK_PRIO, NULL) != pdPASS) {
+        printf("INFO, log drain task create failed -- staying synchronous\n");
+        return;
+    }
+
+    s_active = true;
+    printf("INFO, async log channel active (%d slots x %d bytes)\n",
+           LOG_SLOT_COUNT, LOG_SLOT_BYTES);
+}
@@ -0,0 +1,235 @@
+/* ===================================================================
+ * LatchPac Validator 3000 -- Persistent Result Store (v1)
+ *
+ * Fixed-size record ring on the "results" raw partition.  Records are
+ * packed into 4 KB erase sectors (an integer number of slots per
+ * sector; the few bytes of slack at each sector end stay erased), so
+ * a sector is only ever erased right before the ring writes back into
+ * it -- the oldest sector of history is dropped wholesale when the
+ * ring wraps, and erase cycles spread evenly across the partition.
+ *
+ * Mount scan: the newest record is the one with the highest sequence
+ * number (mod-64K compare, same wraparound rule the serial decoder
+ * uses); writing resumes in the slot after it.  A slot left half
+ * programmed by a crash fails its CRC on dump and is skipped.
+ * =================================================================== */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "esp_partition.h"
+#include "esp_timer.h"
+
+#include "csv_logger.h"
+#include "result_store.h"
+#include "log_async.h"
+
+/* Flush once this many records are buffered (or on state change --
+ * same batching idea as NVS_UNIT_BATCH in main.c). */
+#define RESULT_STORE_BATCH      8
+
+#define STORE_SECTOR_BYTES      4096u
+/* Slot = record rounded up to the 4-byte flash write granularity */
+#define STORE_SLOT_BYTES        ((sizeof(log_record_bin_t) + 3u) & ~3u)
+#define SLOTS_PER_SECTOR        (STORE_SECTOR_BYTES / STORE_SLOT_BYTES)
+
+/* Erased-flash magic: slot has never been programmed */
+#define SLOT_ERASED_MAGIC       0xFFFFu
+
+static const esp_partition_t *s_part        = NULL;
+static uint32_t               s_total_slots = 0;
+static uint32_t               s_write_slot  = 0;   /* Next slot to program */
+static uint16_t               s_next_seq    = 0;
+
+static log_record_bin_t s_batch[RESULT_STORE_BATCH];
+static int              s_batch_count = 0;
+
+/* ------------------------------------------------------------------ */
+/*  Helpers                                                             */
+/* ------------------------------------------------------------------ */
+
+static uint32_t slot_offset(uint32_t slot)
+{
+    return (slot / SLOTS_PER_SECTOR) * STORE_SECTOR_BYTES +
+           (slot % SLOTS_PER_SECTOR) * STORE_SLOT_BYTES;
+}
+
+/* Read just the magic + seq header of a slot */
+static bool slot_read_header(uint32_t slot, uint16_t *magic, uint16_t *seq)
+{
+    uint16_t hdr[2];
+    if (esp_partition_read(s_part, slot_offset(slot), hdr, sizeof(hdr)) != ESP_OK) {
+        return false;
+    }
+    *magic = hdr[0];
+    *seq   = hdr[1];
+    return true;
+}
+
+/* ------------------------------------------------------------------ */
+/*  Public API                                                          */
+/* ------------------------------------------------------------------ */
+
+bool result_store_init(void)
+{
+    s_part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                      ESP_PARTITION_SUBTYPE_ANY,
+                                      RESULT_STORE_PARTITION);
+    if (s_part == NULL) {
+        log_info("INFO, result store: partition '%s' not found -- persistence off\n",
+                 RESULT_STORE_PARTITION);
+        return false;
+    }
+
+    s_total_slots = (s_part->size / STORE_SECTOR_BYTES) * SLOTS_PER_SECTOR;
+
+    bool     found     = false;
+    uint16_t best_seq  = 0;
+    uint32_t best_slot = 0;
+    uint32_t used      = 0;
+
+    for (uint32_t slot = 0; slot < s_total_slots; slot++) {
+        uint16_t magic, seq;
+        if (!slot_read_header(slot, &magic, &seq)) {
+            log_info("INFO, result store: read failed -- persistence off\n");
+            s_part = NULL;
+            return false;
+        }
+        if (magic != LOG_BIN_MAGIC) {
+            continue;
+        }
+        used++;
+        if (!found || (int16_t)(seq - best_seq) > 0) {
+            found     = true;
+            best_seq  = seq;
+            best_slot = slot;
+        }
+    }
+
+    if (found) {
+        s_write_slot = (best_slot + 1) % s_total_slots;
+        s_next_seq   = (uint16_t)(best_seq + 1);
+
+        /* If the resume slot was left half programmed by a crash it is
+         * no longer erased and cannot be cleanly overwritten -- skip to
+         * the next sector boundary, which gets erased before use. */
+        uint16_t magic, seq;
+        if (slot_read_header(s_write_slot, &magic, &seq) &&
+            magic != SLOT_ERASED_MAGIC &&
+            (s_write_slot % SLOTS_PER_SECTOR) != 0) {
+            uint32_t next_sector = s_write_slot / SLOTS_PER_SECTOR + 1;
+            s_write_slot = (next_sector * SLOTS_PER_SECTOR) % s_total_slots;
+        }
+    } else {
+        s_write_slot = 0;
+        s_next_seq   = 0;
+    }
+
+    log_info("INFO, result store: '%s' %lu KB, %lu slots, %lu used, resume at %lu (seq %u)\n",
+             RESULT_STORE_PARTITION,
+             (unsigned long)(s_part->size / 1024),
+             (unsigned long)s_total_slots,
+             (unsigned long)used,
+             (unsigned long)s_write_slot,
+             (unsigned)s_next_seq);
+    return true;
+}
+
+void result_store_append(const log_entry_t *entry)
+{
+    if (s_part == NULL) {
+        return;
+    }
+
+    log_record_build(entry, s_next_seq++,
+                     (int64_t)(esp_timer_get_time() / 1000),
+                     &s_batch[s_batch_count++]);
+
+    if (s_batch_count >= RESULT_STORE_BATCH) {
+        result_store_flush();
+    }
+}
+
+void result_store_flush(void)
+{
+    if (s_part == NULL || s_batch_count == 0) {
+        return;
+    }
+
+    for (int i = 0; i < s_batch_count; i++) {
+        /* Entering a fresh sector: reclaim it (drops the oldest
+         * sector of history once the ring has wrapped) */
+        if ((s_write_slot % SLOTS_PER_SECTOR) == 0) {
+            uint32_t sector_off = (s_write_slot / SLOTS_PER_SECTOR) * STORE_SECTOR_BYTES;
+            if (esp_partition_erase_range(s_part, sector_off,
+                                          STORE_SECTOR_BYTES) != ESP_OK) {
+                log_info("INFO, result store: erase failed at +%lu -- batch dropped\n",
+                         (unsigned long)sector_off);
+                s_batch_count = 0;
+                return;
+            }
+        }
+
+        uint8_t slot_buf[STORE_SLOT_BYTES];
+        memset(slot_buf, 0xFF, sizeof(slot_buf));
+        memcpy(slot_buf, &s_batch[i], sizeof(log_record_bin_t));
+
+        if (esp_partition_write(s_part, slot_offset(s_write_slot),
+                                slot_buf, sizeof(slot_buf)) != ESP_OK) {
+            log_info("INFO, result store: write failed at slot %lu -- batch dropped\n",
+                     (unsigned long)s_write_slot);
+            s_batch_count = 0;
+            return;
+        }
+
+        s_write_slot = (s_write_slot + 1) % s_total_slots;
+    }
+
+    s_batch_count = 0;
+}
+
+int result_store_dump(void)
+{
+    if (s_part == NULL) {
+        printf("INFO, result store: not mounted\n");
+        return 0;
+    }
+
+    result_store_flush();
+
+    log_header_v2();
+
+    int count = 0;
+    for (uint32_t i = 0; i < s_total_slots; i++) {
+        /* Start just past the write pointer so output is oldest-first */
+        uint32_t slot = (s_write_slot + i) % s_total_slots;
+
+        log_record_bin_t rec;
+        if (esp_partition_read(s_part, slot_offset(slot),
+                               &rec, sizeof(rec)) != ESP_OK) {
+            continue;
+        }
+        if (!log_record_check(&rec)) {
+            continue;       /* Erased, corrupt, or half-programmed slot */
+        }
+
+        rec.status[sizeof(rec.status) - 1]         = '\0';
+        rec.fw_version[sizeof(rec.fw_version) - 1] = '\0';
+
+        printf("LOG, %" PRId64 ", %03" PRId32 ", %s, %.2f, 0x%08" PRIX32
+               ", %" PRId32 ", %" PRIu32 ", %s\n",
+               rec.timestamp_ms,
+               rec.unit_id,
+               rec.status,
+               rec.voltage,
+               rec.swd_idcode,
+               rec.swd_attempts,
+               rec.test_duration_ms,
+               rec.fw_version);
+        count++;
+    }
+
+    printf("INFO, result store: %d records dumped\n", count);
+    return count;
+}
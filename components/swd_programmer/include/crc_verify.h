@@ -0,0 +1,80 @@
+#ifndef CRC_VERIFY_H
+#define CRC_VERIFY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "swd_host.h"
+
+/* ===================================================================
+ * LatchPac Validator 3000 -- On-DUT Flash CRC Verification (v1)
+ *
+ * Verifies a DUT firmware image without pulling it over the wire:
+ * a ~40-byte Thumb CRC32 stub is downloaded into DUT RAM via the
+ * MEM-AP, the core is pointed at it through the core-debug registers
+ * (DHCSR/DCRSR/DCRDR), and a single checksum word is read back.
+ * Full-image verification becomes an O(1) readback instead of an
+ * O(image size) transfer.
+ *
+ * The checksum is CRC-32/MPEG-2 computed over little-endian words
+ * (poly 0x04C11DB7, init 0xFFFFFFFF, no reflection, no final XOR) --
+ * the same algorithm as the STM32 hardware CRC unit's default
+ * configuration, so expected values can be cross-checked with any
+ * STM32 tooling.
+ * =================================================================== */
+
+/**
+ * @brief Run the CRC32 stub on the DUT over a memory range.
+ *
+ * Requires the debug domain to be powered (swd_powerup_debug()).
+ * Halts the core, downloads the stub to the base of DUT RAM, executes
+ * it, and reads the checksum back.  The core is left halted; the test
+ * flow resets the DUT afterwards anyway.
+ *
+ * @param addr       Start address on the DUT (word-aligned).
+ * @param byte_count Number of bytes to checksum (multiple of 4).
+ * @param crc_out    Pointer to receive the CRC32 value.
+ * @return SWD_OK on success, error code otherwise.
+ */
+swd_status_t swd_run_crc_stub(uint32_t addr, uint32_t byte_count, uint32_t *crc_out);
+
+/**
+ * @brief Verify a DUT flash image against an expected CRC32.
+ *
+ * Convenience wrapper around swd_run_crc_stub().
+ *
+ * @param flash_addr   Image start address (typically 0x08000000).
+ * @param byte_count   Image length in bytes (multiple of 4).
+ * @param expected_crc Expected CRC-32/MPEG-2 value.
+ * @param actual_crc   Optional pointer to receive the value read back.
+ * @return SWD_OK if the checksum matches, SWD_ERROR on mismatch,
+ *         other codes on SWD/debug failures.
+ */
+swd_status_t swd_verify_image_crc(uint32_t flash_addr, uint32_t byte_count,
+                                  uint32_t expected_crc, uint32_t *actual_crc);
+
+/**
+ * @brief Host-side reference CRC (same algorithm as the DUT stub).
+ *
+ * Use this to derive the expected value from an image held on the
+ * fixture (e.g. a firmware partition).
+ *
+ * @param words      Image data as little-endian 32-bit words.
+ * @param word_count Number of words.
+ * @return CRC-32/MPEG-2 of the data.
+ */
+uint32_t crc32_stm32_words(const uint32_t *words, size_t word_count);
+
+/**
+ * @brief Chained form of crc32_stm32_words() for streamed data.
+ *
+ * Start with 0xFFFFFFFF and feed successive chunks; the final value
+ * equals crc32_stm32_words() over the concatenation.
+ *
+ * @param crc        Running CRC (0xFFFFFFFF for the first chunk).
+ * @param words      Chunk data as little-endian 32-bit words.
+ * @param word_count Number of words in this chunk.
+ * @return Updated running CRC.
+ */
+uint32_t crc32_stm32_update(uint32_t crc, const uint32_t *words, size_t word_count);
+
+#endif /* CRC_VERIFY_H */
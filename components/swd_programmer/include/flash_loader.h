@@ -0,0 +1,86 @@
+#ifndef FLASH_LOADER_H
+#define FLASH_LOADER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "swd_host.h"
+
+/* ===================================================================
+ * LatchPac Validator 3000 -- DUT Flash Programming Engine (v1)
+ *
+ * Programs STM32G030 flash over the MEM-AP, streaming the image from
+ * a partition on the fixture's own flash (no host PC, no ST-LINK):
+ * halt the core (DHCSR), unlock the flash controller (KEYR), erase
+ * the target pages, then batch doubleword programming through the
+ * block-write path.  With the fast SWD backend a 32 KB image is a
+ * few seconds per board, folding the separate programming station
+ * into the validator.
+ *
+ * The image lives in a data partition (label "dut_fw" by default) --
+ * stage it there with:
+ *   parttool.py write_partition --partition-name dut_fw --input fw.bin
+ *
+ * Requires the debug domain to be powered (swd_powerup_debug()).
+ * The core is left halted after programming; reset the DUT to boot
+ * the new image.
+ * =================================================================== */
+
+/** Default partition label holding the DUT image. */
+#define DUT_FW_PARTITION_LABEL  "dut_fw"
+
+/** STM32G030 flash geometry. */
+#define DUT_FLASH_BASE       0x08000000u
+#define DUT_FLASH_PAGE_SIZE  2048u
+
+/**
+ * @brief Unlock the DUT flash controller (KEYR key sequence).
+ * @return SWD_OK on success (or already unlocked), error otherwise.
+ */
+swd_status_t swd_flash_unlock(void);
+
+/**
+ * @brief Re-lock the DUT flash controller.
+ */
+swd_status_t swd_flash_lock(void);
+
+/**
+ * @brief Erase a run of DUT flash pages.
+ * @param first_page  First page number (page = 2 KB).
+ * @param page_count  Number of pages to erase.
+ * @return SWD_OK on success, error code otherwise.
+ */
+swd_status_t swd_flash_erase_pages(uint32_t first_page, uint32_t page_count);
+
+/**
+ * @brief Program words into (previously erased) DUT flash.
+ *
+ * @p dest_addr must be doubleword-aligned and @p word_count even --
+ * the G0 flash programs in 64-bit units.  Flash-busy stalls surface
+ * as MEM-AP WAITs, which the transfer engine absorbs.
+ *
+ * @param dest_addr  DUT flash address (8-byte aligned).
+ * @param words      Data to program.
+ * @param word_count Number of 32-bit words (even).
+ * @return SWD_OK on success, error code otherwise.
+ */
+swd_status_t swd_flash_program(uint32_t dest_addr, const uint32_t *words,
+                               size_t word_count);
+
+/**
+ * @brief Program a DUT image streamed from a fixture flash partition.
+ *
+ * Halts the core, unlocks and erases, streams the partition contents
+ * in batched chunks, re-locks, and verifies the result with the
+ * on-DUT CRC stub (crc_verify).  The expected CRC is accumulated
+ * host-side while streaming, so no second pass over the image.
+ *
+ * @param label       Partition label (NULL for DUT_FW_PARTITION_LABEL).
+ * @param image_bytes Image length; 0 = the whole partition.
+ * @param dest_addr   DUT flash destination (typically DUT_FLASH_BASE).
+ * @return SWD_OK on success (programmed AND verified), error otherwise.
+ */
+swd_status_t swd_flash_program_partition(const char *label,
+                                         uint32_t image_bytes,
+                                         uint32_t dest_addr);
+
+#endif /* FLASH_LOADER_H */
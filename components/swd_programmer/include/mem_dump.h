@@ -0,0 +1,67 @@
+#ifndef MEM_DUMP_H
+#define MEM_DUMP_H
+
+#include <stdint.h>
+#include "swd_host.h"
+
+/* ===================================================================
+ * LatchPac Validator 3000 -- Streamed DUT Memory Dump (v1)
+ *
+ * Pulls an address range off the DUT over SWD and streams it out the
+ * log UART in framed chunks, for failure analysis without moving the
+ * board to a bench debugger.  Chunks ride the pipelined block-read
+ * path (swd_mem_read_block); each chunk is handed to the UART
+ * driver's interrupt-driven TX ring before the next SWD read starts,
+ * so wire reads of chunk N+1 overlap transmission of chunk N.
+ *
+ * Zero-heavy chunks (erased flash, zeroed RAM) are run-length encoded
+ * when that makes them smaller; the flags byte says which form a
+ * chunk took.  tools/decode_log.py resynchronises on the magic and
+ * reassembles the image.
+ * =================================================================== */
+
+/** Memory bytes carried per chunk (one pipelined SWD burst). */
+#define DUMP_CHUNK_BYTES    1024u
+
+#define DUMP_CHUNK_MAGIC    0x4D44u     /* "DM" on the wire */
+
+/** Chunk flags */
+#define DUMP_FLAG_RLE       0x01u       /* Payload is zero-run RLE */
+
+/**
+ * @brief Dump chunk framing header, followed by payload_len bytes.
+ *
+ * Zero-run RLE payload encoding: a non-zero byte stands for itself;
+ * a 0x00 byte is followed by a run count (1..255) of zeros.
+ *
+ * The CRC-16/CCITT covers the header (with the crc field excluded)
+ * and the payload, so a corrupted chunk is detected and the decoder
+ * rescans for the next magic.
+ */
+typedef struct __attribute__((packed)) {
+    uint16_t magic;         /* DUMP_CHUNK_MAGIC                    */
+    uint16_t seq;           /* Incrementing chunk sequence         */
+    uint32_t addr;          /* DUT address of the first byte       */
+    uint16_t raw_len;       /* Memory bytes this chunk covers      */
+    uint16_t payload_len;   /* Bytes following this header         */
+    uint8_t  flags;         /* DUMP_FLAG_*                         */
+    uint8_t  reserved;
+    uint16_t crc;           /* CRC-16/CCITT of header + payload    */
+} dump_chunk_hdr_t;
+
+/**
+ * @brief Connect to the DUT and stream a memory range out the UART.
+ *
+ * Performs the full connect itself (verify IDCODE, power up the
+ * debug domain) and parks the lines via swd_safe_state() on every
+ * exit path, so it can run standalone from the console path.  A
+ * pending safety abort (lid opened) stops the dump within one chunk.
+ *
+ * @param addr       DUT start address (rounded down to a word).
+ * @param byte_count Bytes to dump (rounded up to a word).
+ * @return SWD_OK when the full range was streamed, error code of the
+ *         failing phase otherwise.
+ */
+swd_status_t swd_mem_dump(uint32_t addr, uint32_t byte_count);
+
+#endif /* MEM_DUMP_H */
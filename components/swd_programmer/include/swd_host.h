@@ -22,7 +22,8 @@ typedef enum {
     SWD_ACK_FAULT,
     SWD_PARITY_ERROR,
     SWD_TIMEOUT,
-    SWD_ERROR
+    SWD_ERROR,
+    SWD_ABORTED         /* v10: safety abort (swd_request_abort)      */
 } swd_status_t;
 
 /* ------------------------------------------------------------------ */
@@ -126,7 +127,14 @@ swd_status_t swd_mem_write32(uint32_t addr, uint32_t value);
 
 /**
  * @brief Read a block of 32-bit words from target memory.
- *        Uses auto-increment in CSW for efficient bulk reads.
+ *        Uses auto-increment in CSW for efficient bulk reads,
+ *        re-seeding TAR at each 1 KB auto-increment page boundary.
+ *
+ * Blocks of 8+ words stream pipelined (v8): ORUNDETECT is enabled so
+ * DRW reads run back-to-back with no idle padding, and one CTRL/STAT
+ * check retires the burst.  On overrun the block is automatically
+ * rerun on the conservative ACK-checked path.
+ *
  * @param addr       Target memory start address (must be word-aligned).
  * @param buf        Buffer to receive word_count 32-bit values.
  * @param word_count Number of 32-bit words to read.
@@ -134,6 +142,21 @@ swd_status_t swd_mem_write32(uint32_t addr, uint32_t value);
  */
 swd_status_t swd_mem_read_block(uint32_t addr, uint32_t *buf, size_t word_count);
 
+/**
+ * @brief Write a block of 32-bit words to target memory.
+ *        Sets CSW/TAR once and streams DRW writes with auto-increment,
+ *        re-seeding TAR at each 1 KB auto-increment page boundary.
+ *
+ * Blocks of 8+ words stream pipelined with ORUNDETECT set, the same
+ * scheme (and automatic fallback) as swd_mem_read_block().
+ *
+ * @param addr       Target memory start address (must be word-aligned).
+ * @param buf        Buffer holding word_count 32-bit values to write.
+ * @param word_count Number of 32-bit words to write.
+ * @return SWD_OK on success, error code otherwise.
+ */
+swd_status_t swd_mem_write_block(uint32_t addr, const uint32_t *buf, size_t word_count);
+
 /* ------------------------------------------------------------------ */
 /*  v2 API: Diagnostics                                                 */
 /* ------------------------------------------------------------------ */
@@ -199,4 +222,188 @@ void swd_safe_state(void);
  */
 swd_status_t swd_abort_recovery(void);
 
+/* ------------------------------------------------------------------ */
+/*  v4 API: Wire backends                                               */
+/* ------------------------------------------------------------------ */
+
+/**
+ * @brief Available SWD wire backends.
+ */
+typedef enum {
+    SWD_BACKEND_BITBANG = 0,    /* Delay-paced GPIO driver calls (~500 kHz) */
+    SWD_BACKEND_FAST_GPIO       /* Dedicated-GPIO burst engine   (~6 MHz)   */
+} swd_backend_t;
+
+/**
+ * @brief Select the SWD wire backend at runtime.
+ *
+ * FAST_GPIO drives SWCLK/SWDIO through the ESP32-S3 dedicated-GPIO
+ * peripheral so a full 46-bit transaction is clocked out in one burst.
+ * Only available in direct-wire mode; opto-isolated fixtures always
+ * use the bit-bang path.  On init failure the driver falls back to
+ * bit-bang automatically.
+ *
+ * @param backend  Backend to activate.
+ * @return SWD_OK on success, SWD_ERROR if unavailable (bit-bang stays active).
+ */
+swd_status_t swd_set_backend(swd_backend_t backend);
+
+/**
+ * @brief Query the currently active SWD wire backend.
+ */
+swd_backend_t swd_get_backend(void);
+
+/**
+ * @brief Enable/disable burst mode (v6).
+ *
+ * In burst mode every wire-level transaction attempt runs inside a
+ * critical section, so tick and peripheral interrupts cannot stretch
+ * a half-period mid-packet.  WAIT back-off delays and recovery still
+ * run with interrupts live.  Interrupts are masked ~100 us per
+ * transaction at the slow clock.
+ *
+ * Combine with pinning SWD-heavy tasks to core 1 (the sequencer does
+ * this) to keep UI/logging jitter on core 0 entirely off the bus.
+ */
+void swd_set_burst_mode(bool enable);
+
+/**
+ * @brief Query whether burst mode is active.
+ */
+bool swd_get_burst_mode(void);
+
+/* ------------------------------------------------------------------ */
+/*  v6 API: Adaptive clock training                                     */
+/* ------------------------------------------------------------------ */
+
+/**
+ * @brief Set the bit-bang half-period (us).  0 is valid: the wire
+ *        clock is then paced by GPIO driver-call overhead alone.
+ *        Ignored by the FAST_GPIO backend.
+ */
+void swd_set_delay_us(uint32_t half_period_us);
+
+/**
+ * @brief Read the current bit-bang half-period (us).
+ */
+uint32_t swd_get_delay_us(void);
+
+/**
+ * @brief Train the bit-bang wire clock against the connected DUT.
+ *
+ * Sweeps the half-period downward, running swd_integrity_test() at
+ * each step, and adopts the fastest setting with zero failures after
+ * it survives a longer confirmation run (the guard margin).  On
+ * failure (no DUT responding at any speed) the previous setting is
+ * restored.  Requires the BITBANG backend; main persists the result
+ * in NVS per fixture.
+ *
+ * @param trained_us  Optional out: the adopted half-period (us).
+ * @return SWD_OK if a setting was adopted, SWD_ERROR otherwise.
+ */
+swd_status_t swd_train_clock(uint32_t *trained_us);
+
+/* ------------------------------------------------------------------ */
+/*  v9 API: Wire statistics                                             */
+/* ------------------------------------------------------------------ */
+
+/** WAIT-depth histogram size (matches the driver's WAIT retry limit). */
+#define SWD_STATS_WAIT_DEPTH  8
+
+/**
+ * @brief Always-on wire-level counters.
+ *
+ * Collected unconditionally (plain increments -- negligible cost), so
+ * retry behaviour is visible in production where verbose logging is
+ * off.  A rising WAIT depth on a fixture is the earliest sign of
+ * pogo-pin wear.
+ */
+typedef struct {
+    uint32_t transactions;      /* ACK-checked transfers completed        */
+    uint32_t pipelined;         /* Pipelined block transfers (v8 path)    */
+    uint32_t wait_depth[SWD_STATS_WAIT_DEPTH];
+                                /* [n] = transfers that saw n+1 WAIT ACKs */
+    uint32_t faults;            /* ACK FAULT responses                    */
+    uint32_t parity_errors;     /* Read-data parity mismatches            */
+    uint32_t line_resets;       /* Line resets (init, recovery, resync)   */
+    uint64_t bus_time_us;       /* Wall time spent in wire transfers      */
+} swd_stats_t;
+
+/**
+ * @brief Copy out the current wire statistics.
+ */
+void swd_get_stats(swd_stats_t *out);
+
+/**
+ * @brief Zero the wire statistics (call once per unit tested).
+ */
+void swd_reset_stats(void);
+
+/* ------------------------------------------------------------------ */
+/*  v10 API: Safety abort                                               */
+/* ------------------------------------------------------------------ */
+
+/**
+ * @brief Flag the SWD engine to abort its current operation (ISR-safe).
+ *
+ * The engine checks the flag (a single volatile read) between
+ * transactions, inside WAIT back-off, and per word in the pipelined
+ * block loops, then parks the lines via swd_safe_state() and returns
+ * SWD_ABORTED up the call chain.  Worst-case response is one wire
+ * transaction (~100 us) instead of the 20 ms safety-poll granularity
+ * -- which is what makes long uninterrupted block bursts (flash
+ * programming, CRC verification) acceptable to run at all.
+ *
+ * The flag is sticky: every subsequent SWD call fails fast with
+ * SWD_ABORTED until swd_clear_abort().  The lid ISR sets it; the main
+ * state machine clears it before starting a test.
+ */
+void swd_request_abort(void);
+
+/**
+ * @brief Clear a pending abort so SWD operations may run again.
+ */
+void swd_clear_abort(void);
+
+/**
+ * @brief Query whether an abort is pending.
+ */
+bool swd_abort_pending(void);
+
+/* ------------------------------------------------------------------ */
+/*  v5 API: Shared-bus port switching (dual-DUT)                        */
+/* ------------------------------------------------------------------ */
+
+/**
+ * @brief Retarget the SWD engine at a different pin set (DUT slot).
+ *
+ * Reconfigures the GPIOs for the new port and, if the FAST_GPIO
+ * backend is active, rebuilds the dedicated-GPIO bundles on the new
+ * pins.  The MEM-AP shadow cache is invalidated -- the new target's
+ * bus state is unknown.  No-op if the port is already active.
+ *
+ * Callers on dual-DUT fixtures must hold the bus lock (swd_bus_lock)
+ * around the port switch and every SWD sequence that follows it.
+ * Not available in opto-isolated mode (single-slot wiring).
+ *
+ * @param clk_pin  SWCLK GPIO number for the slot.
+ * @param io_pin   SWDIO GPIO number for the slot.
+ * @param nrst_pin nRST GPIO number for the slot.
+ * @return SWD_OK on success, SWD_ERROR in opto-isolated mode.
+ */
+swd_status_t swd_select_port(int clk_pin, int io_pin, int nrst_pin);
+
+/**
+ * @brief Acquire the SWD bus mutex (blocks until available).
+ *
+ * The SWD engine is a single shared resource; on dual-DUT fixtures
+ * two sequencer tasks interleave their SWD phases through this lock.
+ */
+void swd_bus_lock(void);
+
+/**
+ * @brief Release the SWD bus mutex.
+ */
+void swd_bus_unlock(void);
+
 #endif /* SWD_HOST_H */
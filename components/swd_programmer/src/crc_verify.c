@@ -0,0 +1,238 @@
+/* ===================================================================
+ * LatchPac Validator 3000 -- On-DUT Flash CRC Verification (v1)
+ *
+ * Downloads a small Thumb CRC32 stub into STM32G030 RAM over the
+ * MEM-AP (swd_mem_write_block), runs it under core-debug control,
+ * and reads one checksum word back.  See crc_verify.h for the
+ * algorithm definition (CRC-32/MPEG-2 over little-endian words).
+ *
+ * Core control follows ARMv6-M debug:
+ *   DHCSR  -- halt/resume + status (S_HALT, S_REGRDY)
+ *   DCRSR  -- register transfer select
+ *   DCRDR  -- register transfer data
+ * =================================================================== */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "esp_timer.h"
+#include "esp_rom_sys.h"
+
+#include "swd_host.h"
+#include "crc_verify.h"
+#include "log_async.h"
+
+/* ------------------------------------------------------------------ */
+/*  ARMv6-M core-debug registers                                        */
+/* ------------------------------------------------------------------ */
+#define CORE_DHCSR          0xE000EDF0u
+#define CORE_DCRSR          0xE000EDF4u
+#define CORE_DCRDR          0xE000EDF8u
+
+#define DHCSR_DBGKEY        0xA05F0000u
+#define DHCSR_C_DEBUGEN     (1u << 0)
+#define DHCSR_C_HALT        (1u << 1)
+#define DHCSR_S_REGRDY      (1u << 16)
+#define DHCSR_S_HALT        (1u << 17)
+
+#define DCRSR_WRITE         (1u << 16)
+#define REG_R0              0
+#define REG_R1              1
+#define REG_SP              13
+#define REG_PC              15
+#define REG_XPSR            16
+
+/* ------------------------------------------------------------------ */
+/*  STM32G030 memory map                                                */
+/* ------------------------------------------------------------------ */
+#define DUT_RAM_BASE        0x20000000u
+#define DUT_RAM_TOP         0x20002000u     /* 8 KB SRAM */
+
+/* Poll timeouts */
+#define HALT_TIMEOUT_US     100000          /* 100 ms to halt the core   */
+#define REGRDY_TIMEOUT_US   10000           /* 10 ms per register xfer   */
+#define CRC_RUN_TIMEOUT_US  500000          /* 500 ms for the stub (32KB */
+                                            /* at 16 MHz HSI is ~90 ms)  */
+
+/* ------------------------------------------------------------------ */
+/*  CRC32 stub, loaded at DUT_RAM_BASE                                  */
+/*                                                                      */
+/*  Thumb-1 source (r0 = start address, r1 = byte count):               */
+/*                                                                      */
+/*      ldr   r2, =0xFFFFFFFF   ; crc init                              */
+/*      ldr   r3, =0x04C11DB7   ; polynomial                            */
+/*    word_loop:                                                        */
+/*      cmp   r1, #0                                                    */
+/*      beq   done                                                      */
+/*      ldmia r0!, {r4}                                                 */
+/*      eors  r2, r4            ; crc ^= word                           */
+/*      movs  r5, #32                                                   */
+/*    bit_loop:                                                         */
+/*      lsls  r2, r2, #1        ; carry = old MSB                       */
+/*      bcc   no_xor                                                    */
+/*      eors  r2, r3                                                    */
+/*    no_xor:                                                           */
+/*      subs  r5, #1                                                    */
+/*      bne   bit_loop                                                  */
+/*      subs  r1, #4                                                    */
+/*      b     word_loop                                                 */
+/*    done:                                                             */
+/*      movs  r0, r2                                                    */
+/*      bkpt  #0                ; re-halt, host reads r0                */
+/* ------------------------------------------------------------------ */
+static const uint32_t crc_stub[] = {
+    0x4B084A07,     /* ldr r2, [pc,#28] ; ldr r3, [pc,#32] */
+    0xD0092900,     /* cmp r1, #0       ; beq done         */
+    0x4062C810,     /* ldmia r0!, {r4}  ; eors r2, r4      */
+    0x00522520,     /* movs r5, #32     ; lsls r2, r2, #1  */
+    0x405AD300,     /* bcc no_xor       ; eors r2, r3      */
+    0xD1FA3D01,     /* subs r5, #1      ; bne bit_loop     */
+    0xE7F33904,     /* subs r1, #4      ; b word_loop      */
+    0xBE000010,     /* movs r0, r2      ; bkpt #0          */
+    0xFFFFFFFF,     /* literal: crc init                   */
+    0x04C11DB7,     /* literal: polynomial                 */
+};
+#define CRC_STUB_WORDS  (sizeof(crc_stub) / sizeof(crc_stub[0]))
+
+/* ------------------------------------------------------------------ */
+/*  Core-debug helpers                                                  */
+/* ------------------------------------------------------------------ */
+
+static swd_status_t core_wait_dhcsr_bit(uint32_t bit, int64_t timeout_us)
+{
+    int64_t deadline = esp_timer_get_time() + timeout_us;
+    uint32_t dhcsr = 0;
+    do {
+        swd_status_t st = swd_mem_read32(CORE_DHCSR, &dhcsr);
+        if (st != SWD_OK) return st;
+        if (dhcsr & bit) return SWD_OK;
+        esp_rom_delay_us(50);
+    } while (esp_timer_get_time() < deadline);
+    return SWD_TIMEOUT;
+}
+
+static swd_status_t core_halt(void)
+{
+    swd_status_t st = swd_mem_write32(CORE_DHCSR,
+                                      DHCSR_DBGKEY | DHCSR_C_DEBUGEN | DHCSR_C_HALT);
+    if (st != SWD_OK) return st;
+    return core_wait_dhcsr_bit(DHCSR_S_HALT, HALT_TIMEOUT_US);
+}
+
+static swd_status_t core_resume(void)
+{
+    /* Keep C_DEBUGEN so the trailing BKPT re-halts instead of faulting */
+    return swd_mem_write32(CORE_DHCSR, DHCSR_DBGKEY | DHCSR_C_DEBUGEN);
+}
+
+static swd_status_t core_write_reg(uint8_t regno, uint32_t value)
+{
+    swd_status_t st = swd_mem_write32(CORE_DCRDR, value);
+    if (st != SWD_OK) return st;
+    st = swd_mem_write32(CORE_DCRSR, DCRSR_WRITE | regno);
+    if (st != SWD_OK) return st;
+    return core_wait_dhcsr_bit(DHCSR_S_REGRDY, REGRDY_TIMEOUT_US);
+}
+
+static swd_status_t core_read_reg(uint8_t regno, uint32_t *value)
+{
+    swd_status_t st = swd_mem_write32(CORE_DCRSR, regno);
+    if (st != SWD_OK) return st;
+    st = core_wait_dhcsr_bit(DHCSR_S_REGRDY, REGRDY_TIMEOUT_US);
+    if (st != SWD_OK) return st;
+    return swd_mem_read32(CORE_DCRDR, value);
+}
+
+/* ------------------------------------------------------------------ */
+/*  Public API                                                          */
+/* ------------------------------------------------------------------ */
+
+swd_status_t swd_run_crc_stub(uint32_t addr, uint32_t byte_count, uint32_t *crc_out)
+{
+    swd_status_t st;
+
+    if ((addr & 3) || (byte_count & 3) || byte_count == 0) {
+        return SWD_ERROR;
+    }
+
+    /* Halt the core so RAM and registers are ours */
+    st = core_halt();
+    if (st != SWD_OK) {
+        log_info("INFO, CRC verify: core halt failed (%d)\n", st);
+        return st;
+    }
+
+    /* Download the stub to the base of DUT RAM */
+    st = swd_mem_write_block(DUT_RAM_BASE, crc_stub, CRC_STUB_WORDS);
+    if (st != SWD_OK) {
+        log_info("INFO, CRC verify: stub download failed (%d)\n", st);
+        return st;
+    }
+
+    /* Stage arguments and execution context */
+    st = core_write_reg(REG_R0, addr);
+    if (st == SWD_OK) st = core_write_reg(REG_R1, byte_count);
+    if (st == SWD_OK) st = core_write_reg(REG_SP, DUT_RAM_TOP);
+    if (st == SWD_OK) st = core_write_reg(REG_PC, DUT_RAM_BASE);
+    if (st == SWD_OK) st = core_write_reg(REG_XPSR, 0x01000000);    /* T bit */
+    if (st != SWD_OK) {
+        log_info("INFO, CRC verify: register setup failed (%d)\n", st);
+        return st;
+    }
+
+    /* Run until the trailing BKPT re-halts the core */
+    st = core_resume();
+    if (st != SWD_OK) return st;
+
+    st = core_wait_dhcsr_bit(DHCSR_S_HALT, CRC_RUN_TIMEOUT_US);
+    if (st != SWD_OK) {
+        log_info("INFO, CRC verify: stub did not complete (%d) -- re-halting\n", st);
+        core_halt();    /* Best effort: don't leave the core free-running */
+        return st;
+    }
+
+    /* Checksum comes back in r0 */
+    return core_read_reg(REG_R0, crc_out);
+}
+
+swd_status_t swd_verify_image_crc(uint32_t flash_addr, uint32_t byte_count,
+                                  uint32_t expected_crc, uint32_t *actual_crc)
+{
+    uint32_t crc = 0;
+    swd_status_t st = swd_run_crc_stub(flash_addr, byte_count, &crc);
+    if (actual_crc) *actual_crc = crc;
+    if (st != SWD_OK) return st;
+
+    if (crc != expected_crc) {
+        log_info("INFO, CRC verify MISMATCH: [0x%08lX +%lu] got 0x%08lX, expected 0x%08lX\n",
+               (unsigned long)flash_addr, (unsigned long)byte_count,
+               (unsigned long)crc, (unsigned long)expected_crc);
+        return SWD_ERROR;
+    }
+
+    log_info("INFO, CRC verify OK: [0x%08lX +%lu] = 0x%08lX\n",
+           (unsigned long)flash_addr, (unsigned long)byte_count,
+           (unsigned long)crc);
+    return SWD_OK;
+}
+
+uint32_t crc32_stm32_update(uint32_t crc, const uint32_t *words, size_t word_count)
+{
+    for (size_t i = 0; i < word_count; i++) {
+        crc ^= words[i];
+        for (int b = 0; b < 32; b++) {
+            if (crc & 0x80000000u) {
+                crc = (crc << 1) ^ 0x04C11DB7u;
+            } else {
+                crc <<= 1;
+            }
+        }
+    }
+    return crc;
+}
+
+uint32_t crc32_stm32_words(const uint32_t *words, size_t word_count)
+{
+    return crc32_stm32_update(0xFFFFFFFFu, words, word_count);
+}
@@ -0,0 +1,295 @@
+/* ===================================================================
+ * LatchPac Validator 3000 -- DUT Flash Programming Engine (v1)
+ *
+ * Streams an STM32G030 firmware image from a fixture flash partition
+ * into DUT flash over the MEM-AP.  Follows the RM0454 programming
+ * sequence: unlock via KEYR, page erase via CR.PER/PNB/STRT, then
+ * standard programming (CR.PG) in 64-bit doublewords.  Data goes
+ * through swd_mem_write_block(), so it rides the pipelined block path
+ * and flash-busy stalls surface as MEM-AP WAITs the transfer engine
+ * already absorbs.
+ *
+ * Core control matches crc_verify.c (same ARMv6-M DHCSR register);
+ * the image is verified after programming with the on-DUT CRC stub,
+ * with the expected value accumulated host-side during streaming.
+ * =================================================================== */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "esp_timer.h"
+#include "esp_rom_sys.h"
+#include "esp_partition.h"
+
+#include "swd_host.h"
+#include "crc_verify.h"
+#include "flash_loader.h"
+#include "log_async.h"
+
+/* ------------------------------------------------------------------ */
+/*  ARMv6-M core debug (halt only -- see crc_verify.c for the rest)    */
+/* ------------------------------------------------------------------ */
+#define CORE_DHCSR          0xE000EDF0u
+#define DHCSR_DBGKEY        0xA05F0000u
+#define DHCSR_C_DEBUGEN     (1u << 0)
+#define DHCSR_C_HALT        (1u << 1)
+#define DHCSR_S_HALT        (1u << 17)
+
+#define HALT_TIMEOUT_US     100000
+
+/* ------------------------------------------------------------------ */
+/*  STM32G030 flash controller (RM0454)                                 */
+/* ------------------------------------------------------------------ */
+#define FLASH_R_BASE        0x40022000u
+#define FLASH_KEYR          (FLASH_R_BASE + 0x08u)
+#define FLASH_SR            (FLASH_R_BASE + 0x10u)
+#define FLASH_CR            (FLASH_R_BASE + 0x14u)
+
+#define FLASH_KEY1          0x45670123u
+#define FLASH_KEY2          0xCDEF89ABu
+
+#define FLASH_SR_EOP        (1u << 0)
+#define FLASH_SR_BSY1       (1u << 16)
+/* OPERR, PROGERR, WRPERR, PGAERR, SIZERR, PGSERR, MISERR, FASTERR */
+#define FLASH_SR_ERR_MASK   0x000003FAu
+
+#define FLASH_CR_PG         (1u << 0)
+#define FLASH_CR_PER        (1u << 1)
+#define FLASH_CR_PNB_SHIFT  3
+#define FLASH_CR_STRT       (1u << 16)
+#define FLASH_CR_LOCK       (1u << 31)
+
+/* Page erase is ~22 ms worst case on the G0; doublewords are ~85 us */
+#define ERASE_TIMEOUT_US    100000
+#define PROGRAM_TIMEOUT_US  100000
+
+/* Streaming chunk: 128 words = 512 bytes per partition read */
+#define LOADER_CHUNK_WORDS  128
+
+static uint32_t s_chunk_buf[LOADER_CHUNK_WORDS];
+
+/* ------------------------------------------------------------------ */
+/*  Helpers                                                             */
+/* ------------------------------------------------------------------ */
+
+static swd_status_t loader_core_halt(void)
+{
+    swd_status_t st = swd_mem_write32(CORE_DHCSR,
+                                      DHCSR_DBGKEY | DHCSR_C_DEBUGEN | DHCSR_C_HALT);
+    if (st != SWD_OK) return st;
+
+    int64_t deadline = esp_timer_get_time() + HALT_TIMEOUT_US;
+    uint32_t dhcsr = 0;
+    do {
+        st = swd_mem_read32(CORE_DHCSR, &dhcsr);
+        if (st != SWD_OK) return st;
+        if (dhcsr & DHCSR_S_HALT) return SWD_OK;
+        esp_rom_delay_us(50);
+    } while (esp_timer_get_time() < deadline);
+    return SWD_TIMEOUT;
+}
+
+/* Wait for BSY1 to clear, then check and clear the SR flags.
+ * Any error bit set fails the operation. */
+static swd_status_t flash_wait_done(int64_t timeout_us)
+{
+    int64_t deadline = esp_timer_get_time() + timeout_us;
+    uint32_t sr = 0;
+    swd_status_t st;
+
+    do {
+        st = swd_mem_read32(FLASH_SR, &sr);
+        if (st != SWD_OK) return st;
+        if ((sr & FLASH_SR_BSY1) == 0) break;
+        esp_rom_delay_us(100);
+    } while (esp_timer_get_time() < deadline);
+
+    if (sr & FLASH_SR_BSY1) {
+        return SWD_TIMEOUT;
+    }
+
+    /* SR flags are write-1-to-clear */
+    swd_mem_write32(FLASH_SR, sr & (FLASH_SR_ERR_MASK | FLASH_SR_EOP));
+
+    if (sr & FLASH_SR_ERR_MASK) {
+        log_info("INFO, DUT flash error: SR=0x%08lX\n", (unsigned long)sr);
+        return SWD_ERROR;
+    }
+    return SWD_OK;
+}
+
+/* ------------------------------------------------------------------ */
+/*  Public API                                                          */
+/* ------------------------------------------------------------------ */
+
+swd_status_t swd_flash_unlock(void)
+{
+    uint32_t cr = 0;
+    swd_status_t st = swd_mem_read32(FLASH_CR, &cr);
+    if (st != SWD_OK) return st;
+    if ((cr & FLASH_CR_LOCK) == 0) {
+        return SWD_OK;      /* Already unlocked */
+    }
+
+    st = swd_mem_write32(FLASH_KEYR, FLASH_KEY1);
+    if (st == SWD_OK) st = swd_mem_write32(FLASH_KEYR, FLASH_KEY2);
+    if (st != SWD_OK) return st;
+
+    st = swd_mem_read32(FLASH_CR, &cr);
+    if (st != SWD_OK) return st;
+    if (cr & FLASH_CR_LOCK) {
+        log_info("INFO, DUT flash unlock failed (CR=0x%08lX)\n", (unsigned long)cr);
+        return SWD_ERROR;
+    }
+    return SWD_OK;
+}
+
+swd_status_t swd_flash_lock(void)
+{
+    return swd_mem_write32(FLASH_CR, FLASH_CR_LOCK);
+}
+
+swd_status_t swd_flash_erase_pages(uint32_t first_page, uint32_t page_count)
+{
+    swd_status_t st;
+
+    for (uint32_t p = first_page; p < first_page + page_count; p++) {
+        st = swd_mem_write32(FLASH_CR,
+                             FLASH_CR_PER | (p << FLASH_CR_PNB_SHIFT) | FLASH_CR_STRT);
+        if (st != SWD_OK) return st;
+
+        st = flash_wait_done(ERASE_TIMEOUT_US);
+        if (st != SWD_OK) {
+            log_info("INFO, DUT flash erase failed at page %lu (%d)\n",
+                   (unsigned long)p, st);
+            return st;
+        }
+    }
+
+    /* Drop PER */
+    return swd_mem_write32(FLASH_CR, 0);
+}
+
+swd_status_t swd_flash_program(uint32_t dest_addr, const uint32_t *words,
+                               size_t word_count)
+{
+    swd_status_t st;
+
+    if ((dest_addr & 7) || (word_count & 1) || word_count == 0) {
+        return SWD_ERROR;
+    }
+
+    st = swd_mem_write32(FLASH_CR, FLASH_CR_PG);
+    if (st != SWD_OK) return st;
+
+    /* Batched doubleword stream: consecutive 32-bit writes with TAR
+     * auto-increment complete one 64-bit programming unit per pair */
+    st = swd_mem_write_block(dest_addr, words, word_count);
+    if (st != SWD_OK) {
+        swd_mem_write32(FLASH_CR, 0);
+        return st;
+    }
+
+    st = flash_wait_done(PROGRAM_TIMEOUT_US);
+
+    /* Drop PG (keep the first error as the result) */
+    swd_status_t st_cr = swd_mem_write32(FLASH_CR, 0);
+    return (st != SWD_OK) ? st : st_cr;
+}
+
+swd_status_t swd_flash_program_partition(const char *label,
+                                         uint32_t image_bytes,
+                                         uint32_t dest_addr)
+{
+    swd_status_t st;
+
+    if (label == NULL) {
+        label = DUT_FW_PARTITION_LABEL;
+    }
+
+    const esp_partition_t *part = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (part == NULL) {
+        log_info("INFO, DUT flash: partition '%s' not found -- stage the image first\n",
+               label);
+        return SWD_ERROR;
+    }
+    if (image_bytes == 0 || image_bytes > part->size) {
+        image_bytes = part->size;
+    }
+
+    /* Round up to the 8-byte programming unit (pad reads as 0xFF) */
+    uint32_t padded_bytes = (image_bytes + 7u) & ~7u;
+    uint32_t first_page = (dest_addr - DUT_FLASH_BASE) / DUT_FLASH_PAGE_SIZE;
+    uint32_t page_count = (padded_bytes + DUT_FLASH_PAGE_SIZE - 1) / DUT_FLASH_PAGE_SIZE;
+
+    log_info("INFO, DUT flash: programming %lu bytes from '%s' to 0x%08lX (%lu pages)\n",
+           (unsigned long)image_bytes, label,
+           (unsigned long)dest_addr, (unsigned long)page_count);
+
+    int64_t t0 = esp_timer_get_time();
+
+    st = loader_core_halt();
+    if (st != SWD_OK) {
+        log_info("INFO, DUT flash: core halt failed (%d)\n", st);
+        return st;
+    }
+
+    st = swd_flash_unlock();
+    if (st != SWD_OK) return st;
+
+    st = swd_flash_erase_pages(first_page, page_count);
+    if (st != SWD_OK) {
+        swd_flash_lock();
+        return st;
+    }
+
+    /* Stream chunks, accumulating the expected CRC as we go */
+    uint32_t crc = 0xFFFFFFFFu;
+    uint32_t offset = 0;
+    while (offset < padded_bytes) {
+        uint32_t chunk = padded_bytes - offset;
+        if (chunk > sizeof(s_chunk_buf)) {
+            chunk = sizeof(s_chunk_buf);
+        }
+
+        /* Tail padding: unwritten bytes read back as erased flash */
+        for (size_t i = 0; i < chunk / 4; i++) {
+            s_chunk_buf[i] = 0xFFFFFFFFu;
+        }
+        uint32_t data_bytes = (offset < image_bytes) ? (image_bytes - offset) : 0;
+        if (data_bytes > chunk) data_bytes = chunk;
+        if (data_bytes > 0 &&
+            esp_partition_read(part, offset, s_chunk_buf, data_bytes) != ESP_OK) {
+            log_info("INFO, DUT flash: partition read failed at +%lu\n",
+                   (unsigned long)offset);
+            swd_flash_lock();
+            return SWD_ERROR;
+        }
+
+        st = swd_flash_program(dest_addr + offset, s_chunk_buf, chunk / 4);
+        if (st != SWD_OK) {
+            log_info("INFO, DUT flash: program failed at +%lu (%d)\n",
+                   (unsigned long)offset, st);
+            swd_flash_lock();
+            return st;
+        }
+
+        crc = crc32_stm32_update(crc, s_chunk_buf, chunk / 4);
+        offset += chunk;
+    }
+
+    swd_flash_lock();
+
+    /* Verify with the on-DUT CRC stub -- O(1) readback, no 2nd pass */
+    st = swd_verify_image_crc(dest_addr, padded_bytes, crc, NULL);
+    if (st != SWD_OK) {
+        return st;
+    }
+
+    log_info("INFO, DUT flash: %lu bytes programmed + verified in %lld ms\n",
+           (unsigned long)image_bytes,
+           (long long)((esp_timer_get_time() - t0) / 1000));
+    return SWD_OK;
+}
@@ -0,0 +1,43 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include "csv_logger.h"
+
+/* ===================================================================
+ * LatchPac Validator 3000 -- Wi-Fi Batched Telemetry Uplink (v1)
+ *
+ * Pushes result records (the framed binary format from csv_logger)
+ * plus the SWD wire-health counters to a line collector over TCP, so
+ * yield is visible line-wide without per-PC serial scrapers.
+ *
+ * Posting a record is a build + ring-buffer copy on the caller's
+ * task; a low-priority core-0 task owns the radio and the socket and
+ * pushes a batch every TELEM_BATCH_UNITS records or as a timed
+ * heartbeat.  Batching amortises connection cost to effectively zero
+ * per unit.  Records stay in the RAM ring until a push succeeds;
+ * anything lost to a long outage is still in the persistent result
+ * ring (result_store) for collector replay.
+ *
+ * Everything no-ops unless CONFIG_LATCHPAC_TELEMETRY is enabled and
+ * telemetry_init() succeeded, mirroring result_store.
+ * =================================================================== */
+
+/**
+ * @brief Bring up Wi-Fi STA and start the uplink task.
+ *
+ * Call once at boot, after NVS init (the Wi-Fi stack needs it).  On
+ * any failure the radio stays down and telemetry is simply off for
+ * the session (logged).
+ */
+void telemetry_init(void);
+
+/**
+ * @brief Queue one result for the next batch.  Never blocks: builds
+ *        the binary record and copies it into the RAM ring.  When the
+ *        ring is full the record is dropped here (counted) -- the
+ *        persistent result ring still has it.
+ */
+void telemetry_post_result(const log_entry_t *entry);
+
+#endif /* TELEMETRY_H */
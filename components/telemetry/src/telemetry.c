@@ -0,0 +1,375 @@
+/* ===================================================================
+ * LatchPac Validator 3000 -- Wi-Fi Batched Telemetry Uplink (v1)
+ *
+ * See telemetry.h for the design.  Wire payload:
+ *
+ *   telem_hdr_t                      -- magic, fixture id, counts, CRC
+ *   swd_stats_t                      -- wire-health counter snapshot
+ *   log_record_bin_t * record_count  -- framed binary result records
+ *
+ * The body (stats + records) is zero-run RLE'd when that shrinks it
+ * (records are NUL-pad heavy) -- same scheme as the dump chunks
+ * (mem_dump.h).  CRC-16/CCITT covers the header (crc field zeroed)
+ * and the body as sent.
+ *
+ * The uplink task holds the only socket and connects per batch; the
+ * producers only ever touch the RAM ring under a spinlock.  The ring
+ * drains on push success, so a failed push retries the same records
+ * on the next heartbeat.
+ * =================================================================== */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "csv_logger.h"
+#include "telemetry.h"
+
+#ifdef CONFIG_LATCHPAC_TELEMETRY
+
+#include "esp_timer.h"
+#include "esp_event.h"
+#include "esp_netif.h"
+#include "esp_wifi.h"
+#include "esp_mac.h"
+#include "lwip/sockets.h"
+
+#include "swd_host.h"
+
+#define TELEM_BATCH_UNITS       8       /* Push after this many records */
+#define TELEM_HEARTBEAT_S       60      /* ...or this much silence      */
+#define TELEM_RETRY_BACKOFF_S   30      /* After a failed push          */
+#define TELEM_RING_RECORDS      32      /* RAM buffer between pushes    */
+#define TELEM_SOCKET_TIMEOUT_S  5
+#define TELEM_TASK_PRIO         (tskIDLE_PRIORITY + 1)
+
+#define TELEM_MAGIC             0x544Cu     /* "LT" on the wire */
+#define TELEM_FLAG_RLE          0x01u
+
+typedef struct __attribute__((packed)) {
+    uint16_t magic;             /* TELEM_MAGIC                          */
+    uint16_t record_count;      /* Records in the body                  */
+    uint32_t fixture_id;        /* Low 32 bits of the station MAC       */
+    uint32_t uptime_s;          /* Fixture uptime at push time          */
+    uint8_t  flags;             /* TELEM_FLAG_*                         */
+    uint8_t  reserved;
+    uint16_t body_len;          /* Bytes following this header          */
+    uint16_t crc;               /* CRC-16/CCITT of header + body        */
+} telem_hdr_t;
+
+#define TELEM_BODY_MAX  (sizeof(swd_stats_t) + \
+                         TELEM_RING_RECORDS * sizeof(log_record_bin_t))
+
+/* Producer ring: test tasks write under the spinlock, the uplink
+ * task is the single consumer (tail only moves on push success). */
+static log_record_bin_t s_ring[TELEM_RING_RECORDS];
+static volatile int     s_head = 0;
+static volatile int     s_tail = 0;
+static uint16_t         s_seq = 0;
+static uint32_t         s_dropped = 0;
+static bool             s_active = false;
+static portMUX_TYPE     s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static volatile bool    s_wifi_up = false;
+static uint32_t         s_fixture_id = 0;
+
+/* Uplink-task staging (static: too big for the task stack) */
+static uint8_t s_body[TELEM_BODY_MAX];
+static uint8_t s_rle[TELEM_BODY_MAX];
+
+/* ------------------------------------------------------------------ */
+/*  Producer side                                                       */
+/* ------------------------------------------------------------------ */
+
+void telemetry_post_result(const log_entry_t *entry)
+{
+    if (!s_active) {
+        return;
+    }
+
+    log_record_bin_t rec;
+    log_record_build(entry, s_seq++,
+                     (int64_t)(esp_timer_get_time() / 1000), &rec);
+
+    portENTER_CRITICAL(&s_lock);
+    int next = (s_head + 1) % TELEM_RING_RECORDS;
+    if (next == s_tail) {
+        s_dropped++;    /* Flash result ring still has the record */
+    } else {
+        s_ring[s_head] = rec;
+        s_head = next;
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+/* ------------------------------------------------------------------ */
+/*  Wi-Fi events                                                        */
+/* ------------------------------------------------------------------ */
+
+static void telem_wifi_event(void *arg, esp_event_base_t base,
+                             int32_t id, void *data)
+{
+    (void)arg;
+    (void)data;
+    if (base == WIFI_EVENT && id == WIFI_EVENT_STA_START) {
+        esp_wifi_connect();
+    } else if (base == WIFI_EVENT && id == WIFI_EVENT_STA_DISCONNECTED) {
+        s_wifi_up = false;
+        esp_wifi_connect();     /* Keep retrying; batches queue meanwhile */
+    } else if (base == IP_EVENT && id == IP_EVENT_STA_GOT_IP) {
+        s_wifi_up = true;
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/*  Payload encoding                                                    */
+/* ------------------------------------------------------------------ */
+
+/* CRC-16/CCITT-FALSE, seeded -- same polynomial as the log framing */
+static uint16_t crc16_ccitt(uint16_t crc, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021)
+                                 : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/* Zero-run RLE, same scheme as the dump chunks (mem_dump.h).
+ * Returns the encoded length, or -1 when it would not shrink. */
+static int rle_encode(const uint8_t *src, int len, uint8_t *dst)
+{
+    int out = 0;
+    int i = 0;
+
+    while (i < len) {
+        if (src[i] == 0x00) {
+            int run = 1;
+            while (i + run < len && run < 255 && src[i + run] == 0x00) {
+                run++;
+            }
+            if (out + 2 >= len) {
+                return -1;
+            }
+            dst[out++] = 0x00;
+            dst[out++] = (uint8_t)run;
+            i += run;
+        } else {
+            if (out + 1 >= len) {
+                return -1;
+            }
+            dst[out++] = src[i++];
+        }
+    }
+    return out;
+}
+
+/* ------------------------------------------------------------------ */
+/*  Uplink task                                                         */
+/* ------------------------------------------------------------------ */
+
+static bool telem_send_all(int sock, const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    while (len > 0) {
+        int n = send(sock, p, len, 0);
+        if (n <= 0) {
+            return false;
+        }
+        p   += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+/* Build and push one batch.  The ring tail advances only when the
+ * whole payload went out, so failures retry the same records. */
+static bool telem_push_batch(void)
+{
+    /* Peek pending records (producers only move the head) */
+    int tail = s_tail;
+    int n = 0;
+    size_t body_len = sizeof(swd_stats_t);
+
+    swd_stats_t stats;
+    swd_get_stats(&stats);
+    memcpy(s_body, &stats, sizeof(stats));
+
+    while (tail != s_head && n < TELEM_RING_RECORDS) {
+        memcpy(s_body + body_len, &s_ring[tail], sizeof(log_record_bin_t));
+        body_len += sizeof(log_record_bin_t);
+        tail = (tail + 1) % TELEM_RING_RECORDS;
+        n++;
+    }
+
+    telem_hdr_t hdr = {
+        .magic        = TELEM_MAGIC,
+        .record_count = (uint16_t)n,
+        .fixture_id   = s_fixture_id,
+        .uptime_s     = (uint32_t)(esp_timer_get_time() / 1000000),
+        .flags        = 0,
+        .reserved     = 0,
+        .body_len     = (uint16_t)body_len,
+        .crc          = 0,
+    };
+
+    const uint8_t *body = s_body;
+    int enc = rle_encode(s_body, (int)body_len, s_rle);
+    if (enc > 0) {
+        hdr.flags    = TELEM_FLAG_RLE;
+        hdr.body_len = (uint16_t)enc;
+        body         = s_rle;
+    }
+
+    uint16_t crc = crc16_ccitt(0xFFFF, (const uint8_t *)&hdr,
+                               sizeof(hdr) - sizeof(hdr.crc));
+    hdr.crc = crc16_ccitt(crc, body, hdr.body_len);
+
+    int sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (sock < 0) {
+        return false;
+    }
+    struct timeval tv = { .tv_sec = TELEM_SOCKET_TIMEOUT_S, .tv_usec = 0 };
+    setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    struct sockaddr_in dest = {
+        .sin_family = AF_INET,
+        .sin_port   = htons(CONFIG_LATCHPAC_TELEMETRY_PORT),
+    };
+    dest.sin_addr.s_addr = inet_addr(CONFIG_LATCHPAC_TELEMETRY_HOST);
+
+    bool ok = connect(sock, (struct sockaddr *)&dest, sizeof(dest)) == 0 &&
+              telem_send_all(sock, &hdr, sizeof(hdr)) &&
+              telem_send_all(sock, body, hdr.body_len);
+    close(sock);
+
+    if (ok) {
+        portENTER_CRITICAL(&s_lock);
+        s_tail = tail;      /* Commit: these records are delivered */
+        portEXIT_CRITICAL(&s_lock);
+    }
+    return ok;
+}
+
+static void telemetry_task(void *arg)
+{
+    (void)arg;
+    int64_t last_push_us = esp_timer_get_time();
+    uint32_t reported_drops = 0;
+
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(1000));
+
+        int pending = (s_head - s_tail + TELEM_RING_RECORDS)
+                      % TELEM_RING_RECORDS;
+        int64_t now = esp_timer_get_time();
+        bool due = pending >= TELEM_BATCH_UNITS ||
+                   (now - last_push_us) >= (int64_t)TELEM_HEARTBEAT_S * 1000000;
+
+        if (!due || !s_wifi_up) {
+            continue;       /* Records queue; Wi-Fi reconnects itself */
+        }
+
+        if (telem_push_batch()) {
+            last_push_us = now;
+            uint32_t drops = s_dropped;
+            if (drops != reported_drops) {
+                printf("INFO, telemetry: RAM ring overflowed -- %lu records "
+                       "only in the flash ring\n", (unsigned long)drops);
+                reported_drops = drops;
+            }
+        } else {
+            /* Collector down: hold off, records stay queued */
+            vTaskDelay(pdMS_TO_TICKS(TELEM_RETRY_BACKOFF_S * 1000));
+            last_push_us = esp_timer_get_time();
+        }
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/*  Init                                                                */
+/* ------------------------------------------------------------------ */
+
+void telemetry_init(void)
+{
+    if (s_active) {
+        return;
+    }
+
+    esp_err_t err = esp_netif_init();
+    if (err == ESP_OK) {
+        err = esp_event_loop_create_default();
+        if (err == ESP_ERR_INVALID_STATE) {
+            err = ESP_OK;   /* Someone else made the loop -- fine */
+        }
+    }
+    if (err != ESP_OK) {
+        printf("INFO, telemetry: netif/event init failed (0x%x) -- off\n", err);
+        return;
+    }
+
+    esp_netif_create_default_wifi_sta();
+    wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
+    if (esp_wifi_init(&cfg) != ESP_OK) {
+        printf("INFO, telemetry: Wi-Fi init failed -- off\n");
+        return;
+    }
+
+    esp_event_handler_register(WIFI_EVENT, ESP_EVENT_ANY_ID,
+                               telem_wifi_event, NULL);
+    esp_event_handler_register(IP_EVENT, IP_EVENT_STA_GOT_IP,
+                               telem_wifi_event, NULL);
+
+    wifi_config_t wc = { 0 };
+    strncpy((char *)wc.sta.ssid, CONFIG_LATCHPAC_TELEMETRY_SSID,
+            sizeof(wc.sta.ssid) - 1);
+    strncpy((char *)wc.sta.password, CONFIG_LATCHPAC_TELEMETRY_PASS,
+            sizeof(wc.sta.password) - 1);
+
+    if (esp_wifi_set_mode(WIFI_MODE_STA) != ESP_OK ||
+        esp_wifi_set_config(WIFI_IF_STA, &wc) != ESP_OK ||
+        esp_wifi_start() != ESP_OK) {
+        printf("INFO, telemetry: Wi-Fi start failed -- off\n");
+        return;
+    }
+
+    uint8_t mac[6] = { 0 };
+    esp_read_mac(mac, ESP_MAC_WIFI_STA);
+    s_fixture_id = ((uint32_t)mac[2] << 24) | ((uint32_t)mac[3] << 16) |
+                   ((uint32_t)mac[4] << 8)  |  (uint32_t)mac[5];
+
+    /* Core 0: keep the radio and socket work off the SWD core */
+    if (xTaskCreatePinnedToCore(telemetry_task, "telemetry", 4096, NULL,
+                                TELEM_TASK_PRIO, NULL, 0) != pdPASS) {
+        printf("INFO, telemetry: task create failed -- off\n");
+        return;
+    }
+
+    s_active = true;
+    printf("INFO, telemetry active: fixture %08lX -> %s:%d "
+           "(batch %d units / %d s)\n",
+           (unsigned long)s_fixture_id,
+           CONFIG_LATCHPAC_TELEMETRY_HOST, CONFIG_LATCHPAC_TELEMETRY_PORT,
+           TELEM_BATCH_UNITS, TELEM_HEARTBEAT_S);
+}
+
+#else /* !CONFIG_LATCHPAC_TELEMETRY */
+
+/* Telemetry disabled: posting is a no-op, init logs nothing. */
+
+void telemetry_init(void)
+{
+}
+
+void telemetry_post_result(const log_entry_t *entry)
+{
+    (void)entry;
+}
+
+#endif /* CONFIG_LATCHPAC_TELEMETRY */
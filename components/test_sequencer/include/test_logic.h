@@ -27,7 +27,9 @@ typedef enum {
     FAIL_INCOMPLETE        = 7,   /* Previous test interrupted (power loss)  */
     FAIL_SWD_NO_TARGET     = 8,   /* SWD got no response (ALL_ONES / ERROR)  */
     FAIL_SWD_WRONG_ID      = 9,   /* SWD responded but IDCODE doesn't match */
-    FAIL_SWD_BUS_ERROR     = 10   /* SWD bus fault, parity, or timeout       */
+    FAIL_SWD_BUS_ERROR     = 10,  /* SWD bus fault, parity, or timeout       */
+    /* v4 adaptive-settle code */
+    FAIL_SLOW_SETTLE       = 11   /* Load settled, but not within SETTLE_MS  */
 } test_result_t;
 
 /**
@@ -57,6 +59,19 @@ typedef struct {
     int           swd_attempts;     /* How many SWD retries needed       */
     swd_status_t  swd_status;       /* Raw SWD status from last attempt  */
     uint32_t      duration_ms;      /* Total test execution time (ms)    */
+    /* v4 adaptive-settle measurements (0 if the phase was not reached) */
+    uint32_t      settle_latch_ms;  /* Load ON transition time            */
+    uint32_t      settle_unlatch_ms;/* Load OFF transition time           */
+    /* v6 per-phase cycle-time breakdown (ms; 0 if phase not completed).
+     * Sums to roughly duration_ms; the settle fields above measure the
+     * relay transition alone, these cover the whole step including the
+     * stabilization tail, retries and lid polling. */
+    uint32_t      t_precheck_ms;    /* Steps 0-1: interlock + pre-check  */
+    uint32_t      t_latch_ms;       /* Steps 2-3: latch drive + settle   */
+    uint32_t      t_unlatch_ms;     /* Steps 4-5: unlatch drive + settle */
+    uint32_t      t_swd_verify_ms;  /* Step 7: IDCODE verify (join wait  */
+                                    /* only when overlapped)             */
+    uint32_t      t_debug_probe_ms; /* Step 8: debug powerup + mem probe */
 } test_report_t;
 
 /**
@@ -73,4 +88,47 @@ typedef struct {
  */
 test_report_t run_production_test_v2(void);
 
+/* ------------------------------------------------------------------ */
+/*  v5 API: Dual-DUT slots                                              */
+/* ------------------------------------------------------------------ */
+
+/**
+ * @brief Pin set for one DUT nest ("slot").
+ *
+ * The pogo and load-sense pins belong to the slot exclusively; the
+ * SWD pins describe the slot's port on the shared SWD engine (see
+ * swd_select_port).  Slot tables live in test_logic.c and are built
+ * from fixture_pins.h.
+ */
+typedef struct {
+    int slot_id;        /* 0 = slot A, 1 = slot B                  */
+    int sim_start;      /* Pogo -> START pad GPIO (active LOW)     */
+    int sim_stop;       /* Pogo -> STOP pad GPIO  (active LOW)     */
+    int load_sense;     /* Load-sense input GPIO                   */
+    int swd_clk;        /* Slot SWCLK GPIO                         */
+    int swd_io;         /* Slot SWDIO GPIO                         */
+    int swd_nrst;       /* Slot nRST GPIO                          */
+} test_slot_t;
+
+/** Slot A -- the classic single-nest pin set; always present. */
+extern const test_slot_t TEST_SLOT_A;
+
+#ifdef CONFIG_LATCHPAC_DUAL_DUT
+/** Slot B -- second nest (CONFIG_LATCHPAC_DUAL_DUT fixtures only). */
+extern const test_slot_t TEST_SLOT_B;
+#endif
+
+/**
+ * @brief Run the v2/v3 test cycle against one slot.
+ *
+ * Safe to run from two tasks concurrently (one per slot): relay
+ * settle waits overlap freely while SWD phases serialise through the
+ * engine's bus mutex.  run_production_test_v2() is equivalent to
+ * calling this with &TEST_SLOT_A.
+ *
+ * @param slot  Slot pin set (TEST_SLOT_A or TEST_SLOT_B).
+ * @return test_report_t  Full report struct.
+ */
+test_report_t run_production_test_slot(const test_slot_t *slot);
+
 #endif /* TEST_LOGIC_H */
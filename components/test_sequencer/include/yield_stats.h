@@ -0,0 +1,68 @@
+#ifndef YIELD_STATS_H
+#define YIELD_STATS_H
+
+#include <stdint.h>
+#include "test_logic.h"
+
+/* ===================================================================
+ * LatchPac Validator 3000 -- Yield / Failure-Pareto Statistics (v1)
+ *
+ * On-fixture yield accounting so operators can spot a drifting
+ * fixture mid-shift instead of scraping CSV off the serial port the
+ * next morning.  Everything accumulates incrementally in O(1) memory:
+ *
+ *   - Lifetime per-result counters (one per test_result_t)
+ *   - Rolling last-YIELD_WINDOW yield from a small result ring
+ *   - Mean duration (running sum) and p95 from the same ring,
+ *     sorted only when printed
+ *
+ * Lifetime counters persist across power cycles: main exports the
+ * blob into NVS on the same batched commit schedule as the unit
+ * counter.  The rolling window is session-only by design -- after a
+ * reboot the "recent" picture starts fresh.
+ * =================================================================== */
+
+/** Rolling window length (results and durations retained). */
+#define YIELD_WINDOW        100
+
+/** Number of test_result_t categories tracked. */
+#define YIELD_RESULT_COUNT  (FAIL_SLOW_SETTLE + 1)
+
+/**
+ * @brief Persistable lifetime counters (magic-tagged for NVS).
+ */
+typedef struct {
+    uint32_t magic;                         /* YIELD_BLOB_MAGIC          */
+    uint32_t total;                         /* Units recorded (lifetime) */
+    uint64_t duration_sum_ms;               /* For the lifetime mean     */
+    uint32_t counts[YIELD_RESULT_COUNT];    /* Per-result tallies        */
+} yield_stats_blob_t;
+
+#define YIELD_BLOB_MAGIC    0x59534C50u     /* "PLSY" */
+
+/**
+ * @brief Record one completed unit (call where the report is logged).
+ */
+void yield_stats_record(test_result_t result, uint32_t duration_ms);
+
+/**
+ * @brief Print the yield summary and failure Pareto to serial.
+ *
+ * One INFO line with lifetime + rolling yield and duration stats,
+ * then one line per observed failure category, worst first.  Cheap
+ * enough to run after every unit; also the console's "yield" command.
+ */
+void yield_stats_print(void);
+
+/**
+ * @brief Export the lifetime counters for persistence.
+ */
+void yield_stats_export(yield_stats_blob_t *out);
+
+/**
+ * @brief Restore lifetime counters from a persisted blob.
+ *        Blobs with a wrong magic (or from an older layout) are ignored.
+ */
+void yield_stats_import(const yield_stats_blob_t *in);
+
+#endif /* YIELD_STATS_H */
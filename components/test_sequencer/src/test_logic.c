@@ -16,6 +16,12 @@
  *   - swd_safe_state() called on every exit path
  *   - goto-based cleanup ensures outputs are ALWAYS forced safe
  *
+ * v5 dual-DUT:
+ *   - The whole sequence is parameterised by a test_slot_t pin set so
+ *     two nests can run as parallel tasks (CONFIG_LATCHPAC_DUAL_DUT).
+ *     Relay settle waits overlap; SWD phases take the engine's bus
+ *     mutex and switch ports with swd_select_port().
+ *
  * All pin definitions come from fixture_pins.h -- no local redefinition.
  *
  * SAFETY: The lid interlock is polled during every wait period.
@@ -30,6 +36,7 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "driver/gpio.h"
 #include "esp_timer.h"
 #include "esp_task_wdt.h"
@@ -38,13 +45,90 @@
 #include "mock_hardware.h"
 #include "test_logic.h"
 #include "swd_host.h"
+#include "log_async.h"
 
-/* Settling time after driving pogo outputs (ms) */
+/* Worst-case settle budget after driving pogo outputs (ms).
+ * With adaptive settle (v4) this is the timeout, not the wait. */
 #define SETTLE_MS       500
 
 /* Safety poll interval during waits (ms) */
 #define SAFETY_POLL_MS  20
 
+/* SWD-heavy tasks are pinned to core 1 in burst-mode builds so the
+ * interrupt-masked wire transactions never contend with the UI and
+ * logging interrupt load on core 0 (see CONFIG_LATCHPAC_SWD_BURST). */
+#ifdef CONFIG_LATCHPAC_SWD_BURST
+#define SWD_TASK_CORE   1
+#else
+#define SWD_TASK_CORE   tskNO_AFFINITY
+#endif
+
+/* Stabilization tail after the load-sense transition (ms).
+ * Scope traces show good units settle in 60-120 ms; the tail guards
+ * against contact bounce before we accept the new state. */
+#ifdef CONFIG_LATCHPAC_SETTLE_TAIL_MS
+#define SETTLE_TAIL_MS  CONFIG_LATCHPAC_SETTLE_TAIL_MS
+#else
+#define SETTLE_TAIL_MS  50
+#endif
+
+/* ------------------------------------------------------------------ */
+/*  Slot tables (v5)                                                    */
+/* ------------------------------------------------------------------ */
+
+const test_slot_t TEST_SLOT_A = {
+    .slot_id    = 0,
+    .sim_start  = PIN_SIM_START,
+    .sim_stop   = PIN_SIM_STOP,
+    .load_sense = PIN_LOAD_SENSE,
+    .swd_clk    = PIN_SWD_CLK,
+    .swd_io     = PIN_SWD_IO,
+    .swd_nrst   = PIN_SWD_NRST,
+};
+
+#ifdef CONFIG_LATCHPAC_DUAL_DUT
+const test_slot_t TEST_SLOT_B = {
+    .slot_id    = 1,
+    .sim_start  = PIN_SIM_START_B,
+    .sim_stop   = PIN_SIM_STOP_B,
+    .load_sense = PIN_LOAD_SENSE_B,
+    .swd_clk    = PIN_SWD_CLK_B,
+    .swd_io     = PIN_SWD_IO_B,
+    .swd_nrst   = PIN_SWD_NRST_B,
+};
+#define TEST_MAX_SLOTS  2
+#else
+#define TEST_MAX_SLOTS  1
+#endif
+
+/* ------------------------------------------------------------------ */
+/*  Shared SWD engine access (v5)                                       */
+/*                                                                      */
+/*  On dual-DUT fixtures every SWD phase brackets itself with these:    */
+/*  take the bus mutex, point the engine at the slot's port, run the    */
+/*  sequence, release.  Single-slot builds compile them away.           */
+/* ------------------------------------------------------------------ */
+#ifndef MOCK_HARDWARE_MODE
+
+static void slot_swd_acquire(const test_slot_t *slot)
+{
+#ifdef CONFIG_LATCHPAC_DUAL_DUT
+    swd_bus_lock();
+    swd_select_port(slot->swd_clk, slot->swd_io, slot->swd_nrst);
+#else
+    (void)slot;
+#endif
+}
+
+static void slot_swd_release(void)
+{
+#ifdef CONFIG_LATCHPAC_DUAL_DUT
+    swd_bus_unlock();
+#endif
+}
+
+#endif /* !MOCK_HARDWARE_MODE */
+
 /* ------------------------------------------------------------------ */
 /*  Helper: feed the task watchdog                                      */
 /* ------------------------------------------------------------------ */
@@ -61,75 +145,177 @@ static bool deadline_expired(int64_t deadline_us)
     return esp_timer_get_time() >= deadline_us;
 }
 
+/* ------------------------------------------------------------------ */
+/*  Helper: per-phase timing (v6)                                       */
+/*  Closes out one cycle phase: returns the ms elapsed since *mark and  */
+/*  advances the mark to now.  Feeds the t_*_ms report fields.          */
+/* ------------------------------------------------------------------ */
+static uint32_t phase_elapsed_ms(int64_t *mark)
+{
+    int64_t now = esp_timer_get_time();
+    uint32_t ms = (uint32_t)((now - *mark) / 1000);
+    *mark = now;
+    return ms;
+}
+
 /* ------------------------------------------------------------------ */
 /*  Helper: read the load-sense line (real or mock)                    */
 /* ------------------------------------------------------------------ */
-static bool load_is_on(void)
+static bool load_is_on(const test_slot_t *slot)
 {
 #ifdef MOCK_HARDWARE_MODE
+    (void)slot;
     mock_update_simulation();
     return mock_read_voltage() > 1.0f;
 #else
-    return gpio_get_level(PIN_LOAD_SENSE) == 1;
+    return gpio_get_level(slot->load_sense) == 1;
 #endif
 }
 
 /* ------------------------------------------------------------------ */
 /*  Helper: detailed SWD verify (real or mock)                         */
 /* ------------------------------------------------------------------ */
-static swd_verify_result_t verify_swd_detailed(void)
+static swd_verify_result_t verify_swd_detailed(const test_slot_t *slot)
 {
 #ifdef MOCK_HARDWARE_MODE
-    /* Mock always succeeds with correct IDCODE */
-    swd_verify_result_t r = {
-        .status   = SWD_OK,
-        .idcode   = SWD_IDCODE_STM32G030,
-        .attempts = 1
-    };
+    (void)slot;
+    /* Mock model: clean by default, honours any injected fault
+     * profile (mock_fault_configure).  Status values map 1:1. */
+    swd_verify_result_t r = { .status = SWD_OK, .idcode = 0, .attempts = 1 };
+    r.status = (swd_status_t)mock_swd_verify_detailed(&r.idcode, &r.attempts);
     return r;
 #else
-    return swd_verify_target_detailed();
+    slot_swd_acquire(slot);
+    swd_verify_result_t r = swd_verify_target_detailed();
+    slot_swd_release();
+    return r;
+#endif
+}
+
+/* ------------------------------------------------------------------ */
+/*  Pipelined SWD verify (v4)                                          */
+/*                                                                      */
+/*  The SWD lines are electrically independent of the SIM_START /      */
+/*  SIM_STOP pogo outputs, so the IDCODE verification (reset pulses,   */
+/*  resync preambles, retry delays) can run in a worker task while     */
+/*  the sequencer sits in the latch/unlatch settle waits.  Results     */
+/*  are joined before classification; if the worker cannot be          */
+/*  started the sequencer falls back to the synchronous path.          */
+/*                                                                      */
+/*  Mock mode stays synchronous -- the mock verify is instant.         */
+/* ------------------------------------------------------------------ */
+
+#ifndef MOCK_HARDWARE_MODE
+
+/* Per-slot background-verify context (indexed by slot_id) */
+typedef struct {
+    SemaphoreHandle_t   done_sem;
+    swd_verify_result_t result;
+    bool                in_flight;
+} verify_ctx_t;
+
+static verify_ctx_t s_verify_ctx[TEST_MAX_SLOTS];
+
+static void swd_verify_worker(void *arg)
+{
+    const test_slot_t *slot = (const test_slot_t *)arg;
+    verify_ctx_t *ctx = &s_verify_ctx[slot->slot_id];
+    ctx->result = verify_swd_detailed(slot);
+    xSemaphoreGive(ctx->done_sem);
+    vTaskDelete(NULL);
+}
+
+#endif /* !MOCK_HARDWARE_MODE */
+
+/* Kick off the SWD verify in the background.  Returns false if it
+ * could not be started (caller should verify synchronously). */
+static bool swd_verify_start(const test_slot_t *slot)
+{
+#ifdef MOCK_HARDWARE_MODE
+    (void)slot;
+    return false;
+#else
+    verify_ctx_t *ctx = &s_verify_ctx[slot->slot_id];
+    if (ctx->done_sem == NULL) {
+        ctx->done_sem = xSemaphoreCreateBinary();
+    }
+    if (ctx->done_sem == NULL) {
+        return false;
+    }
+    if (xTaskCreatePinnedToCore(swd_verify_worker, "swd_verify", 4096,
+                    (void *)slot, uxTaskPriorityGet(NULL), NULL,
+                    SWD_TASK_CORE) != pdPASS) {
+        log_info("INFO, SWD verify worker create failed -- verifying inline\n");
+        return false;
+    }
+    ctx->in_flight = true;
+    return true;
 #endif
 }
 
+/* Join the background verify (or run it synchronously if it never
+ * started).  The worker's runtime is bounded by the SWD retry and
+ * wall-clock limits, so an indefinite wait here cannot hang. */
+static swd_verify_result_t swd_verify_join(const test_slot_t *slot, bool started)
+{
+#ifndef MOCK_HARDWARE_MODE
+    verify_ctx_t *ctx = &s_verify_ctx[slot->slot_id];
+    if (started && ctx->in_flight) {
+        xSemaphoreTake(ctx->done_sem, portMAX_DELAY);
+        ctx->in_flight = false;
+        return ctx->result;
+    }
+#endif
+    (void)started;
+    return verify_swd_detailed(slot);   /* Fallback: synchronous verify */
+}
+
 /* ------------------------------------------------------------------ */
 /*  Helper: legacy boolean SWD verify (for v1 API compatibility)       */
 /* ------------------------------------------------------------------ */
-static bool verify_swd(void)
+static bool verify_swd(const test_slot_t *slot)
 {
 #ifdef MOCK_HARDWARE_MODE
+    (void)slot;
     return mock_swd_verify();
 #else
-    return swd_verify_target();
+    slot_swd_acquire(slot);
+    bool ok = swd_verify_target();
+    slot_swd_release();
+    return ok;
 #endif
 }
 
 /* ------------------------------------------------------------------ */
 /*  Helper: attempt debug powerup (real or mock)                       */
 /* ------------------------------------------------------------------ */
-static swd_status_t try_debug_powerup(void)
+static swd_status_t try_debug_powerup(const test_slot_t *slot)
 {
 #ifdef MOCK_HARDWARE_MODE
-    printf("INFO, SWD debug domain active -- MEM-AP ready (mock)\n");
+    (void)slot;
+    log_info("INFO, SWD debug domain active -- MEM-AP ready (mock)\n");
     return SWD_OK;
 #else
-    return swd_powerup_debug();
+    slot_swd_acquire(slot);
+    swd_status_t st = swd_powerup_debug();
+    slot_swd_release();
+    return st;
 #endif
 }
 
 /* ------------------------------------------------------------------ */
 /*  Force pogo outputs to safe state (HIGH = released)                 */
 /* ------------------------------------------------------------------ */
-static void force_outputs_safe(void)
+static void force_outputs_safe(const test_slot_t *slot)
 {
-    gpio_set_level(PIN_SIM_START, 1);
-    gpio_set_level(PIN_SIM_STOP,  1);
+    gpio_set_level(slot->sim_start, 1);
+    gpio_set_level(slot->sim_stop,  1);
 }
 
 /* ------------------------------------------------------------------ */
 /*  Safety-aware delay                                                  */
 /* ------------------------------------------------------------------ */
-static bool safe_delay_ms(int total_ms)
+static bool safe_delay_ms(const test_slot_t *slot, int total_ms)
 {
     int remaining = total_ms;
     while (remaining > 0) {
@@ -138,14 +324,119 @@ static bool safe_delay_ms(int total_ms)
         remaining -= chunk;
 
         if (LID_IS_OPEN()) {
-            printf("INFO, SAFETY -- lid opened during test wait, aborting\n");
-            force_outputs_safe();
+            log_info("INFO, SAFETY -- lid opened during test wait, aborting\n");
+            force_outputs_safe(slot);
             return false;
         }
     }
     return true;
 }
 
+/* ------------------------------------------------------------------ */
+/*  Adaptive load-sense settle (v4)                                    */
+/*                                                                      */
+/*  Instead of parking for the full SETTLE_MS worst case, an ANYEDGE   */
+/*  interrupt on PIN_LOAD_SENSE wakes the sequencer the moment the     */
+/*  load transitions; after a short stabilization tail the new state   */
+/*  is confirmed and the test proceeds.  SETTLE_MS becomes a timeout:  */
+/*  a relay that gets there late is FAIL_SLOW_SETTLE, one that never   */
+/*  gets there keeps the existing NO_LATCH/STUCK_LATCHED signatures.   */
+/*  The lid interlock is still polled at SAFETY_POLL_MS throughout.    */
+/* ------------------------------------------------------------------ */
+
+typedef enum {
+    SETTLE_OK = 0,          /* Reached the wanted state and held it    */
+    SETTLE_SLOW,            /* In the wanted state at timeout, but the */
+                            /* stable tail never completed in budget   */
+    SETTLE_TIMEOUT,         /* Never reached the wanted state          */
+    SETTLE_LID_OPEN         /* Lid opened during the wait              */
+} settle_wait_t;
+
+#ifndef MOCK_HARDWARE_MODE
+
+/* Per-slot load-edge semaphore (the ISR gets its slot's handle as arg) */
+static SemaphoreHandle_t s_load_edge_sem[TEST_MAX_SLOTS];
+
+static void IRAM_ATTR load_sense_isr(void *arg)
+{
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR((SemaphoreHandle_t)arg, &woken);
+    if (woken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void load_sense_arm_isr(const test_slot_t *slot)
+{
+    if (s_load_edge_sem[slot->slot_id] != NULL) {
+        return;     /* Already armed */
+    }
+    s_load_edge_sem[slot->slot_id] = xSemaphoreCreateBinary();
+    if (s_load_edge_sem[slot->slot_id] == NULL) {
+        return;     /* Degrades to pure polling below */
+    }
+    gpio_install_isr_service(0);    /* INVALID_STATE if already installed -- fine */
+    gpio_set_intr_type(slot->load_sense, GPIO_INTR_ANYEDGE);
+    gpio_isr_handler_add(slot->load_sense, load_sense_isr,
+                         s_load_edge_sem[slot->slot_id]);
+    gpio_intr_enable(slot->load_sense);
+}
+
+#endif /* !MOCK_HARDWARE_MODE */
+
+static settle_wait_t wait_load_settle(const test_slot_t *slot, bool want_on,
+                                      uint32_t *settle_ms)
+{
+    int64_t t0 = esp_timer_get_time();
+    int64_t deadline = t0 + (int64_t)SETTLE_MS * 1000;
+
+#ifndef MOCK_HARDWARE_MODE
+    load_sense_arm_isr(slot);
+    SemaphoreHandle_t edge_sem = s_load_edge_sem[slot->slot_id];
+    if (edge_sem != NULL) {
+        xSemaphoreTake(edge_sem, 0);            /* Discard stale edge */
+    }
+#endif
+
+    while (1) {
+        if (LID_IS_OPEN()) {
+            log_info("INFO, SAFETY -- lid opened during settle wait, aborting\n");
+            force_outputs_safe(slot);
+            return SETTLE_LID_OPEN;
+        }
+
+        if (load_is_on(slot) == want_on) {
+            int64_t t_edge = esp_timer_get_time();
+
+            /* Stabilization tail: confirm the state holds */
+            if (!safe_delay_ms(slot, SETTLE_TAIL_MS)) {
+                return SETTLE_LID_OPEN;
+            }
+            if (load_is_on(slot) == want_on) {
+                if (settle_ms) {
+                    *settle_ms = (uint32_t)((t_edge - t0) / 1000);
+                }
+                return SETTLE_OK;
+            }
+            /* Bounced -- keep waiting within the budget */
+        }
+
+        if (esp_timer_get_time() >= deadline) {
+            /* In the wanted state but never stable => slow relay */
+            return (load_is_on(slot) == want_on) ? SETTLE_SLOW : SETTLE_TIMEOUT;
+        }
+
+#ifndef MOCK_HARDWARE_MODE
+        if (edge_sem != NULL) {
+            xSemaphoreTake(edge_sem, pdMS_TO_TICKS(SAFETY_POLL_MS));
+        } else
+#endif
+        {
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
+    }
+}
+
 /* ------------------------------------------------------------------ */
 /*  Classify SWD verify result into granular test failure code          */
 /* ------------------------------------------------------------------ */
@@ -198,6 +489,7 @@ const char *test_result_to_string(test_result_t result)
     case FAIL_SWD_NO_TARGET: return "FAIL_SWD_NO_TARGET";
     case FAIL_SWD_WRONG_ID:  return "FAIL_SWD_WRONG_ID";
     case FAIL_SWD_BUS_ERROR: return "FAIL_SWD_BUS_ERROR";
+    case FAIL_SLOW_SETTLE:   return "FAIL_SLOW_SETTLE";
     default:                 return "FAIL_UNKNOWN";
     }
 }
@@ -208,56 +500,64 @@ const char *test_result_to_string(test_result_t result)
 /* ------------------------------------------------------------------ */
 static test_result_t run_test_core(void)
 {
+    const test_slot_t *slot = &TEST_SLOT_A;     /* v1 path is slot A only */
+
     /* ------ Step 0: Safety interlock ------ */
     if (LID_IS_OPEN()) {
-        printf("INFO, Test aborted -- lid safety open\n");
+        log_info("INFO, Test aborted -- lid safety open\n");
         return FAIL_SAFETY_OPEN;
     }
 
     /* ------ Step 1: Pre-check -- load must be OFF ------ */
-    if (load_is_on()) {
-        printf("INFO, Pre-check failed -- load already energised\n");
+    if (load_is_on(slot)) {
+        log_info("INFO, Pre-check failed -- load already energised\n");
         return FAIL_STUCK_ON;
     }
 
     /* ------ Step 2: Latch -- drive START + STOP LOW ------ */
-    gpio_set_level(PIN_SIM_START, 0);
-    gpio_set_level(PIN_SIM_STOP,  0);
-
-    if (!safe_delay_ms(SETTLE_MS)) {
-        return FAIL_SAFETY_OPEN;
-    }
+    gpio_set_level(slot->sim_start, 0);
+    gpio_set_level(slot->sim_stop,  0);
 
-    /* ------ Step 3: Verify ON ------ */
-    if (!load_is_on()) {
-        force_outputs_safe();
-        printf("INFO, Latch failed -- load did not turn ON\n");
-        return FAIL_NO_LATCH;
+    /* ------ Step 3: Wait for + verify ON (adaptive settle) ------ */
+    {
+        settle_wait_t sw = wait_load_settle(slot, true, NULL);
+        if (sw == SETTLE_LID_OPEN) {
+            return FAIL_SAFETY_OPEN;
+        }
+        if (sw != SETTLE_OK) {
+            force_outputs_safe(slot);
+            log_info("INFO, Latch failed -- load did not turn ON%s\n",
+                   sw == SETTLE_SLOW ? " in time" : "");
+            return (sw == SETTLE_SLOW) ? FAIL_SLOW_SETTLE : FAIL_NO_LATCH;
+        }
     }
 
     /* ------ Step 4: Unlatch -- release both lines HIGH ------ */
-    gpio_set_level(PIN_SIM_START, 1);
-    gpio_set_level(PIN_SIM_STOP,  1);
+    gpio_set_level(slot->sim_start, 1);
+    gpio_set_level(slot->sim_stop,  1);
 
-    if (!safe_delay_ms(SETTLE_MS)) {
-        return FAIL_SAFETY_OPEN;
-    }
-
-    /* ------ Step 5: Verify OFF ------ */
-    if (load_is_on()) {
-        printf("INFO, Unlatch failed -- load stuck ON\n");
-        return FAIL_STUCK_LATCHED;
+    /* ------ Step 5: Wait for + verify OFF (adaptive settle) ------ */
+    {
+        settle_wait_t sw = wait_load_settle(slot, false, NULL);
+        if (sw == SETTLE_LID_OPEN) {
+            return FAIL_SAFETY_OPEN;
+        }
+        if (sw != SETTLE_OK) {
+            log_info("INFO, Unlatch failed -- load stuck ON%s\n",
+                   sw == SETTLE_SLOW ? " too long" : "");
+            return (sw == SETTLE_SLOW) ? FAIL_SLOW_SETTLE : FAIL_STUCK_LATCHED;
+        }
     }
 
     /* ------ Step 6: Final lid check before SWD ------ */
     if (LID_IS_OPEN()) {
-        printf("INFO, Lid opened before SWD check\n");
+        log_info("INFO, Lid opened before SWD check\n");
         return FAIL_SAFETY_OPEN;
     }
 
     /* ------ Step 7: SWD IDCODE verification ------ */
-    if (!verify_swd()) {
-        printf("INFO, SWD verification failed\n");
+    if (!verify_swd(slot)) {
+        log_info("INFO, SWD verification failed\n");
         return FAIL_SWD_ERROR;
     }
 
@@ -283,23 +583,43 @@ test_result_t run_production_test(void)
 /*    - Real SWD attempt count and status in report                    */
 /* ------------------------------------------------------------------ */
 test_report_t run_production_test_v2(void)
+{
+    return run_production_test_slot(&TEST_SLOT_A);
+}
+
+/* ------------------------------------------------------------------ */
+/*  v5 API: run_production_test_slot                                   */
+/*                                                                      */
+/*  The v2/v3 sequence, parameterised by slot.  On dual-DUT fixtures   */
+/*  two of these run as parallel tasks; every SWD phase goes through   */
+/*  slot_swd_acquire() so the shared engine serialises cleanly.        */
+/* ------------------------------------------------------------------ */
+test_report_t run_production_test_slot(const test_slot_t *slot)
 {
     test_report_t report = {
         .result        = TEST_PASS,
         .swd_idcode    = 0,
         .swd_attempts  = 0,
         .swd_status    = SWD_ERROR,
-        .duration_ms   = 0
+        .duration_ms   = 0,
+        .settle_latch_ms   = 0,
+        .settle_unlatch_ms = 0,
+        .t_precheck_ms     = 0,
+        .t_latch_ms        = 0,
+        .t_unlatch_ms      = 0,
+        .t_swd_verify_ms   = 0,
+        .t_debug_probe_ms  = 0
     };
 
     /* Start timing */
     int64_t t_start = esp_timer_get_time();
+    int64_t t_mark  = t_start;      /* Advances at each phase boundary */
     int64_t deadline_us = t_start + ((int64_t)TEST_TIMEOUT_MS * 1000);
 
     /* ====== Step 0: Safety interlock ====== */
     wdt_feed();
     if (LID_IS_OPEN()) {
-        printf("INFO, Test aborted -- lid safety open\n");
+        log_info("INFO, Test aborted -- lid safety open\n");
         report.result = FAIL_SAFETY_OPEN;
         goto done;
     }
@@ -307,76 +627,82 @@ test_report_t run_production_test_v2(void)
     /* ====== Step 1: Pre-check -- load must be OFF ====== */
     wdt_feed();
     if (deadline_expired(deadline_us)) {
-        printf("INFO, TIMEOUT during pre-check\n");
+        log_info("INFO, TIMEOUT during pre-check\n");
         report.result = FAIL_TIMEOUT;
         goto done;
     }
-    if (load_is_on()) {
-        printf("INFO, Pre-check failed -- load already energised\n");
+    if (load_is_on(slot)) {
+        log_info("INFO, Pre-check failed -- load already energised\n");
         report.result = FAIL_STUCK_ON;
         goto done;
     }
+    report.t_precheck_ms = phase_elapsed_ms(&t_mark);
+
+    /* ====== Step 1b: Start SWD verify in the background ======
+     * Runs overlapped with the latch/unlatch settle waits below;
+     * joined at step 7 before classification. */
+    bool verify_started = swd_verify_start(slot);
 
     /* ====== Step 2: Latch -- drive START + STOP LOW ====== */
     wdt_feed();
     if (deadline_expired(deadline_us)) {
-        printf("INFO, TIMEOUT before latch\n");
+        log_info("INFO, TIMEOUT before latch\n");
         report.result = FAIL_TIMEOUT;
         goto done;
     }
-    gpio_set_level(PIN_SIM_START, 0);
-    gpio_set_level(PIN_SIM_STOP,  0);
+    gpio_set_level(slot->sim_start, 0);
+    gpio_set_level(slot->sim_stop,  0);
 
-    if (!safe_delay_ms(SETTLE_MS)) {
-        report.result = FAIL_SAFETY_OPEN;
-        goto done;
-    }
-
-    /* ====== Step 3: Verify ON ====== */
-    wdt_feed();
-    if (deadline_expired(deadline_us)) {
-        printf("INFO, TIMEOUT during latch verify\n");
-        report.result = FAIL_TIMEOUT;
-        goto done;
-    }
-    if (!load_is_on()) {
-        printf("INFO, Latch failed -- load did not turn ON\n");
-        report.result = FAIL_NO_LATCH;
-        goto done;
+    /* ====== Step 3: Wait for + verify ON (adaptive settle) ====== */
+    {
+        settle_wait_t sw = wait_load_settle(slot, true, &report.settle_latch_ms);
+        if (sw == SETTLE_LID_OPEN) {
+            report.result = FAIL_SAFETY_OPEN;
+            goto done;
+        }
+        if (sw != SETTLE_OK) {
+            log_info("INFO, Latch failed -- load did not turn ON%s\n",
+                   sw == SETTLE_SLOW ? " in time" : "");
+            report.result = (sw == SETTLE_SLOW) ? FAIL_SLOW_SETTLE : FAIL_NO_LATCH;
+            goto done;
+        }
     }
+    report.t_latch_ms = phase_elapsed_ms(&t_mark);
 
     /* ====== Step 4: Unlatch -- release both lines HIGH ====== */
     wdt_feed();
     if (deadline_expired(deadline_us)) {
-        printf("INFO, TIMEOUT before unlatch\n");
+        log_info("INFO, TIMEOUT before unlatch\n");
         report.result = FAIL_TIMEOUT;
         goto done;
     }
-    gpio_set_level(PIN_SIM_START, 1);
-    gpio_set_level(PIN_SIM_STOP,  1);
-
-    if (!safe_delay_ms(SETTLE_MS)) {
-        report.result = FAIL_SAFETY_OPEN;
-        goto done;
-    }
+    gpio_set_level(slot->sim_start, 1);
+    gpio_set_level(slot->sim_stop,  1);
 
-    /* ====== Step 5: Verify OFF ====== */
+    /* ====== Step 5: Wait for + verify OFF (adaptive settle) ====== */
     wdt_feed();
-    if (deadline_expired(deadline_us)) {
-        printf("INFO, TIMEOUT during unlatch verify\n");
-        report.result = FAIL_TIMEOUT;
-        goto done;
-    }
-    if (load_is_on()) {
-        printf("INFO, Unlatch failed -- load stuck ON\n");
-        report.result = FAIL_STUCK_LATCHED;
-        goto done;
+    {
+        settle_wait_t sw = wait_load_settle(slot, false, &report.settle_unlatch_ms);
+        if (sw == SETTLE_LID_OPEN) {
+            report.result = FAIL_SAFETY_OPEN;
+            goto done;
+        }
+        if (sw != SETTLE_OK) {
+            log_info("INFO, Unlatch failed -- load stuck ON%s\n",
+                   sw == SETTLE_SLOW ? " too long" : "");
+            report.result = (sw == SETTLE_SLOW) ? FAIL_SLOW_SETTLE : FAIL_STUCK_LATCHED;
+            goto done;
+        }
     }
+    report.t_unlatch_ms = phase_elapsed_ms(&t_mark);
+    log_info("INFO, Load settle: latch=%lums unlatch=%lums\n",
+           (unsigned long)report.settle_latch_ms,
+           (unsigned long)report.settle_unlatch_ms);
 
     /* ====== Step 6: Final lid check before SWD ====== */
     wdt_feed();
     if (LID_IS_OPEN()) {
-        printf("INFO, Lid opened before SWD check\n");
+        log_info("INFO, Lid opened before SWD check\n");
         report.result = FAIL_SAFETY_OPEN;
         goto done;
     }
@@ -384,12 +710,14 @@ test_report_t run_production_test_v2(void)
     /* ====== Step 7: SWD IDCODE verification (granular) ====== */
     wdt_feed();
     if (deadline_expired(deadline_us)) {
-        printf("INFO, TIMEOUT before SWD verify\n");
+        log_info("INFO, TIMEOUT before SWD verify\n");
         report.result = FAIL_TIMEOUT;
         goto done;
     }
+    phase_elapsed_ms(&t_mark);      /* Exclude the step 6 lid check */
     {
-        swd_verify_result_t swd_r = verify_swd_detailed();
+        swd_verify_result_t swd_r = swd_verify_join(slot, verify_started);
+        report.t_swd_verify_ms = phase_elapsed_ms(&t_mark);
         report.swd_idcode   = swd_r.idcode;
         report.swd_attempts = swd_r.attempts;
         report.swd_status   = swd_r.status;
@@ -398,7 +726,7 @@ test_report_t run_production_test_v2(void)
             /* SWD passed -- continue to optional debug probe */
         } else {
             report.result = classify_swd_failure(&swd_r);
-            printf("INFO, SWD verify failed: %s (status=%d, idcode=0x%08lX, attempts=%d)\n",
+            log_info("INFO, SWD verify failed: %s (status=%d, idcode=0x%08lX, attempts=%d)\n",
                    test_result_to_string(report.result),
                    (int)swd_r.status,
                    (unsigned long)swd_r.idcode,
@@ -410,46 +738,64 @@ test_report_t run_production_test_v2(void)
     /* ====== Step 8: SWD debug powerup probe (informational only) ====== */
     wdt_feed();
     {
-        swd_status_t dbg_st = try_debug_powerup();
+        swd_status_t dbg_st = try_debug_powerup(slot);
         if (dbg_st == SWD_OK) {
-            printf("INFO, SWD debug domain active -- MEM-AP ready\n");
+            log_info("INFO, SWD debug domain active -- MEM-AP ready\n");
 
             /* Try reading a known address as a diagnostic */
             uint32_t mem_val = 0;
 #ifdef MOCK_HARDWARE_MODE
             mem_val = 0xDEADBEEF;
-            printf("INFO, SWD memory probe: [0x08000000] = 0x%08lX (mock)\n",
+            log_info("INFO, SWD memory probe: [0x08000000] = 0x%08lX (mock)\n",
                    (unsigned long)mem_val);
 #else
             swd_status_t mem_st = swd_mem_read32(0x08000000, &mem_val);
             if (mem_st == SWD_OK) {
-                printf("INFO, SWD memory probe: [0x08000000] = 0x%08lX\n",
+                log_info("INFO, SWD memory probe: [0x08000000] = 0x%08lX\n",
                        (unsigned long)mem_val);
             } else {
-                printf("INFO, SWD memory probe failed (status=%d) -- not a test failure\n",
+                log_info("INFO, SWD memory probe failed (status=%d) -- not a test failure\n",
                        mem_st);
             }
 #endif
         } else {
-            printf("INFO, SWD debug powerup failed (status=%d) -- not a test failure\n",
+            log_info("INFO, SWD debug powerup failed (status=%d) -- not a test failure\n",
                    dbg_st);
         }
     }
+    report.t_debug_probe_ms = phase_elapsed_ms(&t_mark);
 
     /* If we reach here, everything passed */
     report.result = TEST_PASS;
 
 done:
     /* ====== Cleanup: ALWAYS force safe state ====== */
-    force_outputs_safe();
+    force_outputs_safe(slot);
 #ifndef MOCK_HARDWARE_MODE
+    /* Drain the verify worker before touching the SWD lines --
+     * reached when an earlier step failed while it was in flight */
+    if (s_verify_ctx[slot->slot_id].in_flight) {
+        (void)swd_verify_join(slot, true);
+    }
+    slot_swd_acquire(slot);
     swd_safe_state();
+    slot_swd_release();
 #endif
 
     /* Record timing */
     int64_t t_end = esp_timer_get_time();
     report.duration_ms = (uint32_t)((t_end - t_start) / 1000);
 
+    /* Cycle-time budget: where the milliseconds went.  This is the
+     * line to diff when a fixture's cycle time drifts. */
+    log_info("INFO, Cycle budget: total=%lums pre=%lums latch=%lums unlatch=%lums swd=%lums probe=%lums\n",
+           (unsigned long)report.duration_ms,
+           (unsigned long)report.t_precheck_ms,
+           (unsigned long)report.t_latch_ms,
+           (unsigned long)report.t_unlatch_ms,
+           (unsigned long)report.t_swd_verify_ms,
+           (unsigned long)report.t_debug_probe_ms);
+
     wdt_feed();
     return report;
 }
@@ -0,0 +1,137 @@
+/* ===================================================================
+ * LatchPac Validator 3000 -- Yield / Failure-Pareto Statistics (v1)
+ *
+ * Incremental O(1)-memory accumulation: plain counter increments per
+ * unit, a YIELD_WINDOW-deep ring of recent results and durations, and
+ * all the expensive work (percentile sort, Pareto ranking over 12
+ * categories) deferred to print time.  See yield_stats.h.
+ * =================================================================== */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "test_logic.h"
+#include "yield_stats.h"
+
+/* Lifetime counters (the persisted part) */
+static uint32_t s_counts[YIELD_RESULT_COUNT];
+static uint32_t s_total;
+static uint64_t s_duration_sum_ms;
+
+/* Rolling window (session-only) */
+static uint8_t  s_win_result[YIELD_WINDOW];
+static uint32_t s_win_duration[YIELD_WINDOW];
+static int      s_win_head;     /* Next slot to overwrite  */
+static int      s_win_fill;     /* Valid entries (<= YIELD_WINDOW) */
+
+/* Scratch for the p95 sort -- static like the soak array in main.c,
+ * print-time only so no concurrency concern */
+static uint32_t s_sorted[YIELD_WINDOW];
+
+void yield_stats_record(test_result_t result, uint32_t duration_ms)
+{
+    int idx = (int)result;
+    if (idx < 0 || idx >= YIELD_RESULT_COUNT) {
+        return;
+    }
+
+    s_counts[idx]++;
+    s_total++;
+    s_duration_sum_ms += duration_ms;
+
+    s_win_result[s_win_head]   = (uint8_t)idx;
+    s_win_duration[s_win_head] = duration_ms;
+    s_win_head = (s_win_head + 1) % YIELD_WINDOW;
+    if (s_win_fill < YIELD_WINDOW) {
+        s_win_fill++;
+    }
+}
+
+void yield_stats_print(void)
+{
+    if (s_total == 0) {
+        printf("INFO, YIELD: no units recorded\n");
+        return;
+    }
+
+    /* Rolling window yield + duration percentiles */
+    int win_pass = 0;
+    for (int i = 0; i < s_win_fill; i++) {
+        if (s_win_result[i] == TEST_PASS) {
+            win_pass++;
+        }
+        s_sorted[i] = s_win_duration[i];
+    }
+
+    /* In-place insertion sort, same as the soak report in main.c */
+    for (int i = 1; i < s_win_fill; i++) {
+        uint32_t v = s_sorted[i];
+        int j = i - 1;
+        while (j >= 0 && s_sorted[j] > v) {
+            s_sorted[j + 1] = s_sorted[j];
+            j--;
+        }
+        s_sorted[j + 1] = v;
+    }
+
+    uint32_t fails = s_total - s_counts[TEST_PASS];
+
+    printf("INFO, YIELD: total=%lu pass=%lu (%.1f%%) last-%d=%.1f%% "
+           "mean=%lums p95(last-%d)=%lums\n",
+           (unsigned long)s_total,
+           (unsigned long)s_counts[TEST_PASS],
+           100.0f * (float)s_counts[TEST_PASS] / (float)s_total,
+           s_win_fill,
+           s_win_fill ? 100.0f * (float)win_pass / (float)s_win_fill : 0.0f,
+           (unsigned long)(s_duration_sum_ms / s_total),
+           s_win_fill,
+           s_win_fill ? (unsigned long)s_sorted[(s_win_fill * 95) / 100] : 0ul);
+
+    if (fails == 0) {
+        return;
+    }
+
+    /* Pareto: emit observed failure categories worst-first.  Twelve
+     * categories -- repeated max scan beats carrying a sort around. */
+    bool emitted[YIELD_RESULT_COUNT] = { false };
+    emitted[TEST_PASS] = true;
+
+    for (int rank = 1; ; rank++) {
+        int best = -1;
+        for (int i = 0; i < YIELD_RESULT_COUNT; i++) {
+            if (!emitted[i] && s_counts[i] > 0 &&
+                (best < 0 || s_counts[i] > s_counts[best])) {
+                best = i;
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+        emitted[best] = true;
+        printf("INFO, PARETO %d. %s: %lu (%.1f%% of fails)\n",
+               rank,
+               test_result_to_string((test_result_t)best),
+               (unsigned long)s_counts[best],
+               100.0f * (float)s_counts[best] / (float)fails);
+    }
+}
+
+void yield_stats_export(yield_stats_blob_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    out->magic           = YIELD_BLOB_MAGIC;
+    out->total           = s_total;
+    out->duration_sum_ms = s_duration_sum_ms;
+    memcpy(out->counts, s_counts, sizeof(s_counts));
+}
+
+void yield_stats_import(const yield_stats_blob_t *in)
+{
+    if (in == NULL || in->magic != YIELD_BLOB_MAGIC) {
+        return;
+    }
+    s_total           = in->total;
+    s_duration_sum_ms = in->duration_sum_ms;
+    memcpy(s_counts, in->counts, sizeof(s_counts));
+}
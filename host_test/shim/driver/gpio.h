@@ -0,0 +1,72 @@
+#ifndef HOST_SHIM_DRIVER_GPIO_H
+#define HOST_SHIM_DRIVER_GPIO_H
+
+/* ===================================================================
+ * Host-sim shim for ESP-IDF driver/gpio.h
+ *
+ * Pin levels live in a flat table inside idf_shim.c; gpio_set_level()
+ * and gpio_get_level() read/write it directly so the sequencer and
+ * the mock hardware model see each other's pins exactly as on target.
+ * Direction, pull and interrupt calls are accepted and ignored -- the
+ * mock-mode sequencer never relies on them.
+ * =================================================================== */
+
+#include <stdint.h>
+
+typedef int gpio_num_t;
+
+#define GPIO_NUM_0   0
+#define GPIO_NUM_1   1
+#define GPIO_NUM_2   2
+#define GPIO_NUM_3   3
+#define GPIO_NUM_4   4
+#define GPIO_NUM_5   5
+#define GPIO_NUM_6   6
+#define GPIO_NUM_7   7
+#define GPIO_NUM_8   8
+#define GPIO_NUM_9   9
+#define GPIO_NUM_10  10
+#define GPIO_NUM_11  11
+#define GPIO_NUM_12  12
+#define GPIO_NUM_13  13
+#define GPIO_NUM_14  14
+#define GPIO_NUM_15  15
+#define GPIO_NUM_16  16
+#define GPIO_NUM_17  17
+#define GPIO_NUM_18  18
+#define GPIO_NUM_19  19
+#define GPIO_NUM_20  20
+#define GPIO_NUM_21  21
+
+typedef enum {
+    GPIO_MODE_INPUT,
+    GPIO_MODE_OUTPUT,
+    GPIO_MODE_INPUT_OUTPUT
+} gpio_mode_t;
+
+typedef enum {
+    GPIO_PULLUP_ONLY,
+    GPIO_PULLDOWN_ONLY,
+    GPIO_FLOATING
+} gpio_pull_mode_t;
+
+typedef enum {
+    GPIO_INTR_DISABLE,
+    GPIO_INTR_NEGEDGE,
+    GPIO_INTR_POSEDGE,
+    GPIO_INTR_ANYEDGE
+} gpio_int_type_t;
+
+typedef void (*gpio_isr_t)(void *arg);
+
+int gpio_set_level(gpio_num_t pin, uint32_t level);
+int gpio_get_level(gpio_num_t pin);
+int gpio_reset_pin(gpio_num_t pin);
+int gpio_set_direction(gpio_num_t pin, gpio_mode_t mode);
+int gpio_set_pull_mode(gpio_num_t pin, gpio_pull_mode_t pull);
+int gpio_install_isr_service(int flags);
+int gpio_set_intr_type(gpio_num_t pin, gpio_int_type_t type);
+int gpio_isr_handler_add(gpio_num_t pin, gpio_isr_t handler, void *arg);
+int gpio_intr_enable(gpio_num_t pin);
+
+#endif /* HOST_SHIM_DRIVER_GPIO_H */
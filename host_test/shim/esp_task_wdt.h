@@ -0,0 +1,8 @@
+#ifndef HOST_SHIM_ESP_TASK_WDT_H
+#define HOST_SHIM_ESP_TASK_WDT_H
+
+/* Host-sim shim for esp_task_wdt.h -- no watchdog on the host. */
+
+int esp_task_wdt_reset(void);
+
+#endif /* HOST_SHIM_ESP_TASK_WDT_H */
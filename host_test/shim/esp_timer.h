@@ -0,0 +1,11 @@
+#ifndef HOST_SHIM_ESP_TIMER_H
+#define HOST_SHIM_ESP_TIMER_H
+
+/* Host-sim shim for esp_timer.h -- returns the virtual clock, which
+ * only advances through vTaskDelay() / sim_advance_us(). */
+
+#include <stdint.h>
+
+int64_t esp_timer_get_time(void);
+
+#endif /* HOST_SHIM_ESP_TIMER_H */
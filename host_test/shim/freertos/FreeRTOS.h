@@ -0,0 +1,31 @@
+#ifndef HOST_SHIM_FREERTOS_H
+#define HOST_SHIM_FREERTOS_H
+
+/* ===================================================================
+ * Host-sim shim for freertos/FreeRTOS.h
+ *
+ * The simulation is single-threaded: there is no scheduler, and
+ * vTaskDelay() advances the virtual clock instead of sleeping (see
+ * idf_shim.c).  One tick == one millisecond, as on the target.
+ * =================================================================== */
+
+#include <stdint.h>
+
+typedef int          BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t     TickType_t;
+
+#define pdTRUE   1
+#define pdFALSE  0
+#define pdPASS   1
+#define pdFAIL   0
+
+#define portMAX_DELAY       ((TickType_t)0xFFFFFFFFu)
+#define portTICK_PERIOD_MS  1
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(ms))
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+#endif /* HOST_SHIM_FREERTOS_H */
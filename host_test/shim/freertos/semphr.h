@@ -0,0 +1,17 @@
+#ifndef HOST_SHIM_FREERTOS_SEMPHR_H
+#define HOST_SHIM_FREERTOS_SEMPHR_H
+
+/* Host-sim shim for freertos/semphr.h -- single-threaded counting
+ * fakes: Give sets a flag, Take consumes it or fails immediately
+ * (there is no second task that could ever give later). */
+
+#include "freertos/FreeRTOS.h"
+
+typedef void *SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+
+#endif /* HOST_SHIM_FREERTOS_SEMPHR_H */
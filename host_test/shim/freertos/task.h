@@ -0,0 +1,24 @@
+#ifndef HOST_SHIM_FREERTOS_TASK_H
+#define HOST_SHIM_FREERTOS_TASK_H
+
+/* Host-sim shim for freertos/task.h -- see FreeRTOS.h shim.
+ * vTaskDelay() advances the virtual clock; task creation always
+ * fails, which pushes the sequencer onto its synchronous fallback
+ * paths (the overlap optimisations are target-only behaviour). */
+
+#include "freertos/FreeRTOS.h"
+
+#define tskNO_AFFINITY  (-1)
+
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *arg);
+
+void vTaskDelay(TickType_t ticks);
+void vTaskDelete(TaskHandle_t task);
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name,
+                                   uint32_t stack_depth, void *arg,
+                                   UBaseType_t priority, TaskHandle_t *handle,
+                                   BaseType_t core_id);
+
+#endif /* HOST_SHIM_FREERTOS_TASK_H */
@@ -0,0 +1,206 @@
+/* ===================================================================
+ * LatchPac Validator 3000 -- Host Simulation Shim
+ *
+ * Implements just enough of the ESP-IDF / FreeRTOS surface for
+ * test_logic.c, csv_logger.c and mock_hardware.c to run natively on
+ * Linux.  The key trick is the virtual clock: esp_timer_get_time()
+ * reads a counter that only vTaskDelay() advances, so the sequencer's
+ * settle tails and safety polls complete at CPU speed while every
+ * timestamp, timeout and duration computation behaves exactly as on
+ * target.  One mocked test cycle that takes >1 s of wall time on the
+ * ESP32-S3 runs in microseconds here.
+ *
+ * The log_async API is shimmed straight to stdout -- the host build
+ * validates sequencer logic, not the UART drain path.
+ * =================================================================== */
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_task_wdt.h"
+#include "log_async.h"
+#include "sim_clock.h"
+
+/* ------------------------------------------------------------------ */
+/*  Virtual clock                                                       */
+/* ------------------------------------------------------------------ */
+static int64_t s_virtual_us;
+
+int64_t esp_timer_get_time(void)
+{
+    return s_virtual_us;
+}
+
+void sim_advance_us(int64_t us)
+{
+    s_virtual_us += us;
+}
+
+/* ------------------------------------------------------------------ */
+/*  Simulated GPIO levels                                               */
+/* ------------------------------------------------------------------ */
+#define SIM_GPIO_COUNT  64
+
+static int s_gpio_level[SIM_GPIO_COUNT];
+
+int gpio_set_level(gpio_num_t pin, uint32_t level)
+{
+    if (pin >= 0 && pin < SIM_GPIO_COUNT) {
+        s_gpio_level[pin] = (level != 0);
+    }
+    return 0;
+}
+
+int gpio_get_level(gpio_num_t pin)
+{
+    if (pin >= 0 && pin < SIM_GPIO_COUNT) {
+        return s_gpio_level[pin];
+    }
+    return 0;
+}
+
+int gpio_reset_pin(gpio_num_t pin)                              { (void)pin; return 0; }
+int gpio_set_direction(gpio_num_t pin, gpio_mode_t mode)        { (void)pin; (void)mode; return 0; }
+int gpio_set_pull_mode(gpio_num_t pin, gpio_pull_mode_t pull)   { (void)pin; (void)pull; return 0; }
+int gpio_install_isr_service(int flags)                         { (void)flags; return 0; }
+int gpio_set_intr_type(gpio_num_t pin, gpio_int_type_t type)    { (void)pin; (void)type; return 0; }
+int gpio_isr_handler_add(gpio_num_t pin, gpio_isr_t h, void *a) { (void)pin; (void)h; (void)a; return 0; }
+int gpio_intr_enable(gpio_num_t pin)                            { (void)pin; return 0; }
+
+void sim_reset(void)
+{
+    s_virtual_us = 0;
+    for (int i = 0; i < SIM_GPIO_COUNT; i++) {
+        s_gpio_level[i] = 0;
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/*  FreeRTOS fakes (single-threaded)                                    */
+/* ------------------------------------------------------------------ */
+void vTaskDelay(TickType_t ticks)
+{
+    /* 1 tick == 1 ms on target; advance virtual time, never sleep */
+    s_virtual_us += (int64_t)ticks * 1000;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    (void)task;
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task)
+{
+    (void)task;
+    return 5;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name,
+                                   uint32_t stack_depth, void *arg,
+                                   UBaseType_t priority, TaskHandle_t *handle,
+                                   BaseType_t core_id)
+{
+    /* No scheduler: refuse, so callers take their synchronous
+     * fallback paths (the sequencer handles this by design). */
+    (void)fn; (void)name; (void)stack_depth; (void)arg;
+    (void)priority; (void)handle; (void)core_id;
+    return pdFAIL;
+}
+
+/* Binary semaphore fake: Give sets a flag, Take consumes it.  With a
+ * single thread nothing can give while a take is blocked, so a take
+ * on an empty semaphore fails immediately regardless of timeout. */
+static int s_sem_flags[8];
+static int s_sem_used;
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    if (s_sem_used >= (int)(sizeof(s_sem_flags) / sizeof(s_sem_flags[0]))) {
+        return NULL;
+    }
+    s_sem_flags[s_sem_used] = 0;
+    return &s_sem_flags[s_sem_used++];
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    SemaphoreHandle_t sem = xSemaphoreCreateBinary();
+    if (sem != NULL) {
+        *(int *)sem = 1;    /* Mutexes start released */
+    }
+    return sem;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    (void)ticks;
+    if (sem != NULL && *(int *)sem != 0) {
+        *(int *)sem = 0;
+        return pdTRUE;
+    }
+    return pdFALSE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem)
+{
+    if (sem != NULL) {
+        *(int *)sem = 1;
+        return pdTRUE;
+    }
+    return pdFALSE;
+}
+
+/* ------------------------------------------------------------------ */
+/*  Watchdog                                                            */
+/* ------------------------------------------------------------------ */
+int esp_task_wdt_reset(void)
+{
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+/*  log_async shim -- straight to stdout                                */
+/* ------------------------------------------------------------------ */
+void log_async_init(void)
+{
+}
+
+bool log_async_active(void)
+{
+    return false;
+}
+
+void log_info(const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
+
+void log_async_write(const char *line)
+{
+    fputs(line, stdout);
+}
+
+void log_async_write_bytes(const void *data, int len)
+{
+    fwrite(data, 1, (size_t)len, stdout);
+}
+
+uint32_t log_async_dropped(void)
+{
+    return 0;
+}
+
+bool log_async_post_result(const log_raw_result_t *raw)
+{
+    (void)raw;
+    return false;   /* No drain task on the host -- format synchronously */
+}
@@ -0,0 +1,16 @@
+#ifndef HOST_SIM_CLOCK_H
+#define HOST_SIM_CLOCK_H
+
+/* Virtual-clock controls for the host simulation (idf_shim.c).
+ * esp_timer_get_time() reads this clock; vTaskDelay() advances it,
+ * so every real-time wait in the sequencer completes at CPU speed. */
+
+#include <stdint.h>
+
+/* Advance the virtual clock by @p us microseconds. */
+void sim_advance_us(int64_t us);
+
+/* Reset the virtual clock and all simulated GPIO levels to zero. */
+void sim_reset(void);
+
+#endif /* HOST_SIM_CLOCK_H */
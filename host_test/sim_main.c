@@ -0,0 +1,141 @@
+/* ===================================================================
+ * LatchPac Validator 3000 -- Host Simulation Regression Runner
+ *
+ * Drives run_production_test_v2() against the mock hardware model at
+ * CPU speed (virtual clock -- see idf_shim.c) and checks the result
+ * codes the sequencer is contractually expected to produce.  A full
+ * pass here takes well under a second for thousands of cycles that
+ * would need hours of real time on the fixture.
+ *
+ * Exit status is the number of failed checks (0 = green), so the
+ * binary doubles as the CTest gate.
+ * =================================================================== */
+
+#include <stdio.h>
+
+#include "driver/gpio.h"
+#include "fixture_pins.h"
+#include "mock_hardware.h"
+#include "test_logic.h"
+#include "csv_logger.h"
+#include "sim_clock.h"
+
+#define SIM_PASS_ITERATIONS  10000
+
+static int s_checks;
+static int s_failures;
+
+/* Put the fixture in its idle electrical state: pogo outputs released
+ * (active-low), lid closed, virtual clock at zero. */
+static void fixture_reset(void)
+{
+    sim_reset();
+    gpio_set_level(PIN_SIM_START, 1);
+    gpio_set_level(PIN_SIM_STOP,  1);
+    gpio_set_level(PIN_LID_SAFETY, 0);      /* NC to GND = closed */
+    mock_update_simulation();
+}
+
+static void check(const char *what, test_result_t got, test_result_t want)
+{
+    s_checks++;
+    if (got != want) {
+        s_failures++;
+        printf("CHECK FAILED: %s -- got %s, want %s\n",
+               what, test_result_to_string(got), test_result_to_string(want));
+    }
+}
+
+int main(void)
+{
+    printf("INFO, LatchPac host simulation -- sequencer regression\n");
+
+    /* ---- Single-cycle sanity + virtual-clock plausibility ---- */
+    fixture_reset();
+    {
+        test_report_t r = run_production_test_v2();
+        check("clean cycle passes", r.result, TEST_PASS);
+
+        /* Two settle tails must show up in virtual time, or the
+         * clock plumbing is broken and every timeout check is void */
+        s_checks++;
+        if (r.duration_ms < 100) {
+            s_failures++;
+            printf("CHECK FAILED: virtual clock -- duration_ms=%lu (< 100)\n",
+                   (unsigned long)r.duration_ms);
+        }
+        log_entry_t entry = {
+            .unit_id = 1, .status = test_result_to_string(r.result),
+            .voltage = mock_read_voltage(), .swd_idcode = r.swd_idcode,
+            .swd_attempts = r.swd_attempts,
+            .test_duration_ms = r.duration_ms, .fw_version = "host-sim"
+        };
+        log_header_v2();
+        log_result_v2(&entry);
+    }
+
+    /* ---- Lid open at entry -> safety abort ---- */
+    fixture_reset();
+    gpio_set_level(PIN_LID_SAFETY, 1);
+    check("open lid aborts", run_production_test_v2().result, FAIL_SAFETY_OPEN);
+
+    /* ---- Load energised before the test -> pre-check failure ---- */
+    fixture_reset();
+    gpio_set_level(PIN_SIM_START, 0);
+    gpio_set_level(PIN_SIM_STOP,  0);
+    check("stuck-on load fails pre-check",
+          run_production_test_v2().result, FAIL_STUCK_ON);
+
+    /* ---- Fault model: wrong part on the pogo pins ---- */
+    fixture_reset();
+    {
+        mock_fault_profile_t profile = { .swd_wrong_id_pct = 100 };
+        mock_fault_configure(&profile);
+        mock_fault_seed(1);
+        check("wrong IDCODE classified",
+              run_production_test_v2().result, FAIL_SWD_WRONG_ID);
+        mock_fault_configure(NULL);
+    }
+
+    /* ---- Timing model: slow settle shows up in cycle time ---- */
+    fixture_reset();
+    {
+        mock_fault_profile_t profile = { .settle_delay_ms = 80 };
+        mock_fault_configure(&profile);
+        test_report_t r = run_production_test_v2();
+        check("slow-settle cycle still passes", r.result, TEST_PASS);
+
+        /* Two latch edges, each held up ~80 ms beyond the clean model */
+        s_checks++;
+        if (r.duration_ms < 260) {
+            s_failures++;
+            printf("CHECK FAILED: settle model -- duration_ms=%lu (< 260)\n",
+                   (unsigned long)r.duration_ms);
+        }
+        mock_fault_configure(NULL);
+    }
+
+    /* ---- Bulk regression: every cycle must pass, back-to-back ---- */
+    fixture_reset();
+    {
+        int passes = 0;
+        for (int i = 0; i < SIM_PASS_ITERATIONS; i++) {
+            if (run_production_test_v2().result == TEST_PASS) {
+                passes++;
+            }
+        }
+        s_checks++;
+        if (passes != SIM_PASS_ITERATIONS) {
+            s_failures++;
+            printf("CHECK FAILED: bulk regression -- %d/%d passed\n",
+                   passes, SIM_PASS_ITERATIONS);
+        } else {
+            printf("INFO, bulk regression: %d/%d cycles passed\n",
+                   passes, SIM_PASS_ITERATIONS);
+        }
+    }
+
+    printf("INFO, host simulation done: %d checks, %d failures\n",
+           s_checks, s_failures);
+    return s_failures;
+}
@@ -0,0 +1,227 @@
+/* ===================================================================
+ * LatchPac Validator 3000 -- UART Command Console (v1)
+ *
+ * Minimal line reader on the log UART (no esp_console dependency):
+ * bytes accumulate into a line buffer until CR/LF, then one strcmp
+ * dispatch.  The reader task blocks in uart_read_bytes() at low
+ * priority, so it costs nothing while idle and can never stall the
+ * sequencer.  See console.h for the execute-now vs defer-to-IDLE
+ * split.
+ *
+ * Responses go through printf/the dump helpers, so they appear on the
+ * same INFO/LOG channel the line PC already parses.
+ * =================================================================== */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/uart.h"
+#include "nvs.h"
+
+#include "fixture_pins.h"
+#include "swd_host.h"
+#include "flash_loader.h"
+#include "yield_stats.h"
+#include "result_store.h"
+#include "log_async.h"
+#include "console.h"
+
+#define CONSOLE_UART        UART_NUM_0  /* Shared with the log channel */
+#define CONSOLE_RX_CHUNK    32
+#define CONSOLE_LINE_MAX    64
+
+/* NVS location of the trained SWD half-period -- matches main.c */
+#define CONSOLE_NVS_NAMESPACE   "fixture"
+#define CONSOLE_NVS_KEY_DELAY   "swd_delay_us"
+
+/* One-deep request mailbox: console task writes, IDLE state reads */
+static portMUX_TYPE   s_req_mux  = portMUX_INITIALIZER_UNLOCKED;
+static console_req_t  s_req_kind = CONSOLE_REQ_NONE;
+static int            s_req_arg  = 0;
+static uint32_t       s_req_addr = 0;
+
+static void console_post_request(console_req_t kind, int arg, uint32_t addr)
+{
+    portENTER_CRITICAL(&s_req_mux);
+    s_req_kind = kind;
+    s_req_arg  = arg;
+    s_req_addr = addr;
+    portEXIT_CRITICAL(&s_req_mux);
+    printf("INFO, console: queued -- runs when the fixture is IDLE\n");
+}
+
+console_req_t console_take_request(int *arg, uint32_t *addr)
+{
+    portENTER_CRITICAL(&s_req_mux);
+    console_req_t kind = s_req_kind;
+    if (arg)  *arg  = s_req_arg;
+    if (addr) *addr = s_req_addr;
+    s_req_kind = CONSOLE_REQ_NONE;
+    portEXIT_CRITICAL(&s_req_mux);
+    return kind;
+}
+
+/* ------------------------------------------------------------------ */
+/*  Command handlers                                                    */
+/* ------------------------------------------------------------------ */
+
+static void cmd_help(void)
+{
+    printf("INFO, console commands:\n");
+    printf("INFO,   help           -- this list\n");
+    printf("INFO,   yield          -- yield summary + failure Pareto\n");
+    printf("INFO,   results        -- replay the on-flash result backlog\n");
+    printf("INFO,   stats          -- SWD wire counters (current unit)\n");
+    printf("INFO,   clk [us]       -- show / set SWD half-period (persisted)\n");
+    printf("INFO,   test <n>       -- run n test cycles from IDLE (soak-style)\n");
+    printf("INFO,   integrity <n>  -- n-iteration SWD integrity run from IDLE\n");
+    printf("INFO,   train          -- re-train the SWD clock from IDLE\n");
+    printf("INFO,   dump [addr] [len] -- stream DUT memory out the UART\n");
+}
+
+static void cmd_stats(void)
+{
+    swd_stats_t ws;
+    swd_get_stats(&ws);
+
+    uint32_t waits = 0;
+    int max_depth = 0;
+    for (int i = 0; i < SWD_STATS_WAIT_DEPTH; i++) {
+        waits += ws.wait_depth[i];
+        if (ws.wait_depth[i] > 0) max_depth = i + 1;
+    }
+    printf("INFO, SWD wire stats: xfers=%lu pipelined=%lu waits=%lu "
+           "max_wait_depth=%d faults=%lu parity=%lu line_resets=%lu bus=%lums\n",
+           (unsigned long)ws.transactions,
+           (unsigned long)ws.pipelined,
+           (unsigned long)waits, max_depth,
+           (unsigned long)ws.faults,
+           (unsigned long)ws.parity_errors,
+           (unsigned long)ws.line_resets,
+           (unsigned long)(ws.bus_time_us / 1000));
+}
+
+static void cmd_clk(const char *arg)
+{
+    if (arg == NULL) {
+        printf("INFO, SWD half-period: %lu us\n",
+               (unsigned long)swd_get_delay_us());
+        return;
+    }
+
+    long us = strtol(arg, NULL, 10);
+    if (us < 0 || us > 100) {
+        printf("INFO, console: clk out of range (0..100 us)\n");
+        return;
+    }
+
+    swd_set_delay_us((uint32_t)us);
+
+    nvs_handle_t handle;
+    if (nvs_open(CONSOLE_NVS_NAMESPACE, NVS_READWRITE, &handle) == ESP_OK) {
+        nvs_set_u32(handle, CONSOLE_NVS_KEY_DELAY, (uint32_t)us);
+        nvs_commit(handle);
+        nvs_close(handle);
+    }
+    printf("INFO, SWD half-period set to %ld us (persisted)\n", us);
+}
+
+static void console_dispatch(char *line)
+{
+    char *cmd = strtok(line, " \t");
+    if (cmd == NULL) {
+        return;     /* Blank line */
+    }
+    char *arg  = strtok(NULL, " \t");
+    char *arg2 = strtok(NULL, " \t");
+
+    if (strcmp(cmd, "help") == 0) {
+        cmd_help();
+    } else if (strcmp(cmd, "yield") == 0) {
+        yield_stats_print();
+    } else if (strcmp(cmd, "results") == 0) {
+        result_store_dump();
+    } else if (strcmp(cmd, "stats") == 0) {
+        cmd_stats();
+    } else if (strcmp(cmd, "clk") == 0) {
+        cmd_clk(arg);
+    } else if (strcmp(cmd, "test") == 0) {
+        int n = arg ? (int)strtol(arg, NULL, 10) : 1;
+        if (n < 1) n = 1;
+        console_post_request(CONSOLE_REQ_BATCH, n, 0);
+    } else if (strcmp(cmd, "integrity") == 0) {
+        int n = arg ? (int)strtol(arg, NULL, 10) : 10;
+        if (n < 1) n = 1;
+        console_post_request(CONSOLE_REQ_INTEGRITY, n, 0);
+    } else if (strcmp(cmd, "train") == 0) {
+        console_post_request(CONSOLE_REQ_RETRAIN, 0, 0);
+    } else if (strcmp(cmd, "dump") == 0) {
+        /* Defaults: full 32 KB DUT flash image */
+        uint32_t addr = arg  ? (uint32_t)strtoul(arg,  NULL, 0) : DUT_FLASH_BASE;
+        long     len  = arg2 ? strtol(arg2, NULL, 0) : (32 * 1024);
+        if (len < 4 || len > (256 * 1024)) {
+            printf("INFO, console: dump length out of range (4..262144)\n");
+            return;
+        }
+        console_post_request(CONSOLE_REQ_DUMP, (int)len, addr);
+    } else {
+        printf("INFO, console: unknown command '%s' (try 'help')\n", cmd);
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/*  Reader task                                                         */
+/* ------------------------------------------------------------------ */
+
+static void console_task(void *param)
+{
+    (void)param;
+    static char line[CONSOLE_LINE_MAX];
+    size_t line_len = 0;
+    uint8_t chunk[CONSOLE_RX_CHUNK];
+
+    while (1) {
+        int n = uart_read_bytes(CONSOLE_UART, chunk, sizeof(chunk),
+                                pdMS_TO_TICKS(100));
+        for (int i = 0; i < n; i++) {
+            char c = (char)chunk[i];
+            if (c == '\n' || c == '\r') {
+                if (line_len > 0) {
+                    line[line_len] = '\0';
+                    console_dispatch(line);
+                    line_len = 0;
+                }
+            } else if (line_len < sizeof(line) - 1) {
+                line[line_len++] = c;
+            }
+            /* Overlong lines: excess bytes dropped until EOL */
+        }
+    }
+}
+
+void console_start(void)
+{
+    /* log_async_init() installs the UART driver; if it did not run
+     * (or failed), install a minimal RX-only configuration here. */
+    if (!log_async_active()) {
+        if (uart_driver_install(CONSOLE_UART, 256, 0, 0, NULL, 0) != ESP_OK) {
+            printf("INFO, console: UART driver install failed -- console off\n");
+            return;
+        }
+    }
+
+#ifdef CONFIG_LATCHPAC_SWD_BURST
+    const BaseType_t core = 0;  /* Keep console I/O off the SWD core */
+#else
+    const BaseType_t core = tskNO_AFFINITY;
+#endif
+    if (xTaskCreatePinnedToCore(console_task, "console", 4096, NULL,
+                                tskIDLE_PRIORITY + 1, NULL, core) != pdPASS) {
+        printf("INFO, console: task create failed -- console off\n");
+        return;
+    }
+    printf("INFO, console ready ('help' lists commands)\n");
+}
@@ -0,0 +1,56 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+/* ===================================================================
+ * LatchPac Validator 3000 -- UART Command Console (v1)
+ *
+ * Line-oriented console on the log UART so the line PC (or an
+ * operator with a terminal) can trigger diagnostics without power
+ * cycling or button choreography.  A low-priority reader task parses
+ * commands; read-only commands (yield, results, stats, clk) execute
+ * immediately, while anything that drives hardware (test batches,
+ * integrity runs, clock retraining) is posted to a one-deep request
+ * mailbox that the main state machine services from IDLE -- the test
+ * hot path gains no polling or blocking I/O.
+ *
+ * Scripted batch runs ("test 20") are how golden-unit verification at
+ * shift start gets automated.
+ *
+ * v2 adds:
+ *   - "dump [addr] [len]" -- streamed DUT memory dump for failure
+ *     analysis (swd_mem_dump), deferred to IDLE like the other
+ *     hardware commands.
+ * =================================================================== */
+
+#include <stdint.h>
+
+/**
+ * @brief Hardware-touching requests deferred to the IDLE state.
+ */
+typedef enum {
+    CONSOLE_REQ_NONE = 0,
+    CONSOLE_REQ_BATCH,          /* arg = test iterations (soak-style)   */
+    CONSOLE_REQ_INTEGRITY,      /* arg = IDCODE-read iterations         */
+    CONSOLE_REQ_RETRAIN,        /* Re-train the SWD wire clock          */
+    CONSOLE_REQ_DUMP            /* arg = byte count, addr = DUT address */
+} console_req_t;
+
+/**
+ * @brief Start the console reader task.  Call after log_async_init().
+ *        On failure the fixture simply has no console (logged).
+ */
+void console_start(void);
+
+/**
+ * @brief Fetch and clear the pending request, if any.
+ *
+ * Called by the main loop from IDLE.  Requests do not queue: the
+ * latest command wins until it is taken.
+ *
+ * @param arg  Receives the request argument (iterations / byte count).
+ * @param addr Receives the DUT address (CONSOLE_REQ_DUMP only).
+ * @return The pending request kind, or CONSOLE_REQ_NONE.
+ */
+console_req_t console_take_request(int *arg, uint32_t *addr);
+
+#endif /* CONSOLE_H */
@@ -22,8 +22,13 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/event_groups.h"
+#include "freertos/semphr.h"
+#include "freertos/timers.h"
 #include "driver/gpio.h"
 #include "esp_app_desc.h"
+#include "esp_attr.h"
+#include "esp_system.h"
 #include "nvs_flash.h"
 #include "nvs.h"
 #include "esp_timer.h"
@@ -32,12 +37,18 @@
 #include "fixture_pins.h"
 #include "mock_hardware.h"
 #include "test_logic.h"
+#include "yield_stats.h"
 #include "csv_logger.h"
+#include "log_async.h"
+#include "result_store.h"
+#include "console.h"
 #include "swd_host.h"
+#include "mem_dump.h"
+#include "telemetry.h"
 
 /* ---------- Constants ---------- */
 #define DEBOUNCE_MS         50
-#define POLL_MS             20
+#define UI_IDLE_WAIT_MS     500     /* Heartbeat for the event-driven idle wait */
 #define FAIL_BLINK_COUNT    5
 #define FAIL_BLINK_MS       300
 #define BOOT_BLINK_COUNT    3
@@ -49,6 +60,12 @@
 #define NVS_KEY_UNIT_ID     "unit_id"
 #define NVS_KEY_SESSION     "session_count"
 #define NVS_KEY_TEST_ACTIVE "test_active"
+#define NVS_KEY_SWD_DELAY   "swd_delay_us"
+#define NVS_KEY_YIELD       "yield_stats"
+
+/* NVS unit-counter commits are batched: one flash commit per this
+ * many units (plus one on clean shutdown) instead of one per test. */
+#define NVS_UNIT_BATCH      25
 
 /* ---------- State Machine ---------- */
 typedef enum {
@@ -63,6 +80,54 @@ static fixture_state_t  state          = STATE_IDLE;
 static const char      *fw_version_str = NULL;
 static bool             boot_test_was_interrupted = false;  /* v3: set by nvs_init */
 
+/* ------------------------------------------------------------------ */
+/*  RTC-memory journal (v4)                                             */
+/*                                                                      */
+/*  The interrupted-test flag and unit counter used to cost three NVS  */
+/*  flash commits per unit.  They now live in RTC slow memory, which   */
+/*  survives every reset path except full power loss (crash, WDT,      */
+/*  brownout reset, esp_restart) -- updating it is a few stores.  NVS  */
+/*  remains the cold-boot fallback: the unit counter is batch-commited */
+/*  every NVS_UNIT_BATCH units and on clean shutdown, and a sticky     */
+/*  session-dirty flag (one commit per boot, on the first test) lets   */
+/*  us flag a possible interruption when power was lost outright and   */
+/*  the journal is gone.                                               */
+/* ------------------------------------------------------------------ */
+
+#define RTC_JOURNAL_MAGIC   0x4C50414Au     /* "JAPL" */
+
+typedef struct {
+    uint32_t magic;
+    int32_t  unit_counter;
+    int32_t  test_active;
+    uint32_t checksum;
+} rtc_journal_t;
+
+static RTC_NOINIT_ATTR rtc_journal_t s_rtc_journal;
+
+static bool nvs_session_dirty = false;      /* NVS test-active flag written */
+static int  last_committed_unit = 0;        /* Unit counter as stored in NVS */
+
+static uint32_t rtc_journal_checksum(const rtc_journal_t *j)
+{
+    return j->magic ^ (uint32_t)j->unit_counter
+                    ^ (uint32_t)j->test_active ^ 0xB5B5B5B5u;
+}
+
+static bool rtc_journal_valid(void)
+{
+    return s_rtc_journal.magic == RTC_JOURNAL_MAGIC &&
+           s_rtc_journal.checksum == rtc_journal_checksum(&s_rtc_journal);
+}
+
+static void rtc_journal_update(int unit, bool active)
+{
+    s_rtc_journal.magic        = RTC_JOURNAL_MAGIC;
+    s_rtc_journal.unit_counter = unit;
+    s_rtc_journal.test_active  = active ? 1 : 0;
+    s_rtc_journal.checksum     = rtc_journal_checksum(&s_rtc_journal);
+}
+
 /* ------------------------------------------------------------------ */
 /*  NVS Persistent Storage                                              */
 /* ------------------------------------------------------------------ */
@@ -96,45 +161,204 @@ static void nvs_init_counters(void)
     int32_t uid = 0;
     nvs_get_i32(handle, NVS_KEY_UNIT_ID, &uid);
     unit_counter = (int)uid;
+    last_committed_unit = unit_counter;
 
-    /* Check for interrupted test (power loss during STATE_TESTING) */
+    /* Read the sticky session-dirty flag (set on first test, cleared
+     * only on clean shutdown) */
     int32_t test_active = 0;
     nvs_get_i32(handle, NVS_KEY_TEST_ACTIVE, &test_active);
-    if (test_active != 0) {
-        printf("INFO, *** WARNING: Previous test #%d was interrupted (power loss or crash) ***\n",
-               unit_counter);
-        printf("INFO, *** Unit #%d result UNKNOWN -- re-test required ***\n", unit_counter);
-        /* Clear the flag so we don't report it again next boot */
-        nvs_set_i32(handle, NVS_KEY_TEST_ACTIVE, 0);
+
+    /* Restore lifetime yield counters (persisted on the same batched
+     * schedule as the unit counter; a bad/missing blob is ignored) */
+    {
+        yield_stats_blob_t blob;
+        size_t blob_len = sizeof(blob);
+        if (nvs_get_blob(handle, NVS_KEY_YIELD, &blob, &blob_len) == ESP_OK &&
+            blob_len == sizeof(blob)) {
+            yield_stats_import(&blob);
+        }
+    }
+
+    /* Interrupted-test detection: the RTC journal is authoritative on
+     * any warm reset (crash, WDT, brownout reset, esp_restart); it is
+     * lost on full power loss, where the sticky NVS flag tells us a
+     * session was in progress when the power went away. */
+    if (rtc_journal_valid()) {
+        if (s_rtc_journal.unit_counter > unit_counter) {
+            unit_counter = (int)s_rtc_journal.unit_counter;
+        }
+        if (s_rtc_journal.test_active != 0) {
+            printf("INFO, *** WARNING: Previous test #%d was interrupted (crash or reset) ***\n",
+                   unit_counter);
+            printf("INFO, *** Unit #%d result UNKNOWN -- re-test required ***\n", unit_counter);
+            boot_test_was_interrupted = true;
+        }
+    } else if (test_active != 0) {
+        printf("INFO, *** WARNING: Power was lost mid-session (journal gone) ***\n");
+        printf("INFO, *** Unit #%d result UNKNOWN -- re-test required; counter may lag by up to %d ***\n",
+               unit_counter, NVS_UNIT_BATCH - 1);
         boot_test_was_interrupted = true;
     }
 
+    /* Re-seed the journal for this session; clear the stale NVS flag */
+    rtc_journal_update(unit_counter, false);
+    nvs_set_i32(handle, NVS_KEY_TEST_ACTIVE, 0);
+    nvs_set_i32(handle, NVS_KEY_UNIT_ID, (int32_t)unit_counter);
+    last_committed_unit = unit_counter;
+
     nvs_commit(handle);
     nvs_close(handle);
 
     printf("INFO, Session #%d, resuming at unit #%d\n", session_count, unit_counter);
 }
 
+/* Commit the unit counter to NVS only once per NVS_UNIT_BATCH units;
+ * the RTC journal carries the exact value across warm resets. */
 static void nvs_save_unit_counter(void)
 {
+    rtc_journal_update(unit_counter, s_rtc_journal.test_active != 0);
+
+    if (unit_counter - last_committed_unit < NVS_UNIT_BATCH) {
+        return;
+    }
+
     nvs_handle_t handle;
     if (nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle) == ESP_OK) {
+        yield_stats_blob_t blob;
+        yield_stats_export(&blob);
         nvs_set_i32(handle, NVS_KEY_UNIT_ID, (int32_t)unit_counter);
+        nvs_set_blob(handle, NVS_KEY_YIELD, &blob, sizeof(blob));
         nvs_commit(handle);
         nvs_close(handle);
+        last_committed_unit = unit_counter;
     }
 }
 
 static void nvs_set_test_active(bool active)
 {
+    /* Exact per-test tracking lives in the RTC journal (cheap) */
+    rtc_journal_update(unit_counter, active);
+
+    /* One NVS commit per session marks it dirty for the power-loss
+     * fallback; cleared on clean shutdown */
+    if (active && !nvs_session_dirty) {
+        nvs_handle_t handle;
+        if (nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle) == ESP_OK) {
+            nvs_set_i32(handle, NVS_KEY_TEST_ACTIVE, 1);
+            nvs_commit(handle);
+            nvs_close(handle);
+            nvs_session_dirty = true;
+        }
+    }
+}
+
+/* Clean shutdown (esp_restart): flush the exact counter and clear the
+ * session-dirty flag so the next boot does not report a false
+ * interruption. */
+static void nvs_shutdown_flush(void)
+{
+    /* Push any buffered result records out first (no-op if the store
+     * is not mounted) */
+    result_store_flush();
+
     nvs_handle_t handle;
     if (nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle) == ESP_OK) {
-        nvs_set_i32(handle, NVS_KEY_TEST_ACTIVE, active ? 1 : 0);
+        yield_stats_blob_t blob;
+        yield_stats_export(&blob);
+        nvs_set_i32(handle, NVS_KEY_UNIT_ID, (int32_t)unit_counter);
+        nvs_set_i32(handle, NVS_KEY_TEST_ACTIVE,
+                    s_rtc_journal.test_active != 0 ? 1 : 0);
+        nvs_set_blob(handle, NVS_KEY_YIELD, &blob, sizeof(blob));
         nvs_commit(handle);
         nvs_close(handle);
     }
 }
 
+/* ------------------------------------------------------------------ */
+/*  Interrupt-driven operator input (v3)                               */
+/*                                                                      */
+/*  The START button and lid microswitch feed a FreeRTOS event group   */
+/*  instead of a 20 ms polling loop.  The button ISR arms a software   */
+/*  timer for debounce; the timer callback confirms the level and      */
+/*  posts the event.  The lid ISR posts on any edge so both the IDLE   */
+/*  and RESULT states can block until something actually happens.      */
+/* ------------------------------------------------------------------ */
+
+#define UI_EVT_START_PRESSED    (1u << 0)
+#define UI_EVT_LID_CHANGED      (1u << 1)
+
+static EventGroupHandle_t s_ui_events       = NULL;
+static TimerHandle_t      s_debounce_timer  = NULL;
+
+static void IRAM_ATTR start_button_isr(void *arg)
+{
+    (void)arg;
+    BaseType_t woken = pdFALSE;
+    /* (Re)arm the debounce window; confirmation happens in the callback */
+    xTimerResetFromISR(s_debounce_timer, &woken);
+    if (woken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void debounce_timer_cb(TimerHandle_t timer)
+{
+    (void)timer;
+    if (BUTTON_PRESSED(PIN_START_BUTTON)) {
+        xEventGroupSetBits(s_ui_events, UI_EVT_START_PRESSED);
+    }
+}
+
+static void IRAM_ATTR lid_safety_isr(void *arg)
+{
+    (void)arg;
+    /* Lid opening: flag the SWD engine so an in-flight operation
+     * aborts between transactions (microseconds) rather than at the
+     * next 20 ms safety poll.  Closing edges don't set it. */
+    if (LID_IS_OPEN()) {
+        swd_request_abort();
+    }
+    BaseType_t woken = pdFALSE;
+    xEventGroupSetBitsFromISR(s_ui_events, UI_EVT_LID_CHANGED, &woken);
+    if (woken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void ui_input_init(void)
+{
+    s_ui_events = xEventGroupCreate();
+    s_debounce_timer = xTimerCreate("debounce", pdMS_TO_TICKS(DEBOUNCE_MS),
+                                    pdFALSE, NULL, debounce_timer_cb);
+    if (s_ui_events == NULL || s_debounce_timer == NULL) {
+        printf("INFO, UI event setup failed -- operator input unavailable\n");
+        return;
+    }
+
+    gpio_install_isr_service(0);    /* INVALID_STATE if already installed -- fine */
+
+    gpio_set_intr_type(PIN_START_BUTTON, GPIO_INTR_NEGEDGE);
+    gpio_isr_handler_add(PIN_START_BUTTON, start_button_isr, NULL);
+    gpio_intr_enable(PIN_START_BUTTON);
+
+    gpio_set_intr_type(PIN_LID_SAFETY, GPIO_INTR_ANYEDGE);
+    gpio_isr_handler_add(PIN_LID_SAFETY, lid_safety_isr, NULL);
+    gpio_intr_enable(PIN_LID_SAFETY);
+}
+
+/* Block until UI activity (or the heartbeat timeout), returning the
+ * consumed event bits. */
+static EventBits_t ui_wait_events(EventBits_t bits, int timeout_ms)
+{
+    if (s_ui_events == NULL) {
+        /* Degraded mode: no events -- pace the loop like the old poll */
+        vTaskDelay(pdMS_TO_TICKS(timeout_ms));
+        return 0;
+    }
+    return xEventGroupWaitBits(s_ui_events, bits, pdTRUE, pdFALSE,
+                               pdMS_TO_TICKS(timeout_ms)) & bits;
+}
+
 /* ------------------------------------------------------------------ */
 /*  GPIO Initialisation                                                */
 /* ------------------------------------------------------------------ */
@@ -168,6 +392,34 @@ static void gpio_init_all(void)
 
     gpio_reset_pin(PIN_LOAD_SENSE);
     gpio_set_direction(PIN_LOAD_SENSE, GPIO_MODE_INPUT);
+
+#ifdef CONFIG_LATCHPAC_DUAL_DUT
+    /* Slot B nest -- same treatment as the slot A pins above.  The
+     * slot B SWD port is configured by swd_select_port() on first
+     * use, but nRST_B must be held deasserted from boot. */
+    gpio_reset_pin(PIN_SIM_START_B);
+    gpio_set_direction(PIN_SIM_START_B, GPIO_MODE_INPUT_OUTPUT);
+    gpio_set_level(PIN_SIM_START_B, 1);
+
+    gpio_reset_pin(PIN_SIM_STOP_B);
+    gpio_set_direction(PIN_SIM_STOP_B, GPIO_MODE_INPUT_OUTPUT);
+    gpio_set_level(PIN_SIM_STOP_B, 1);
+
+    gpio_reset_pin(PIN_LOAD_SENSE_B);
+    gpio_set_direction(PIN_LOAD_SENSE_B, GPIO_MODE_INPUT);
+
+    gpio_reset_pin(PIN_SWD_CLK_B);
+    gpio_set_direction(PIN_SWD_CLK_B, GPIO_MODE_OUTPUT);
+    gpio_set_level(PIN_SWD_CLK_B, 0);
+
+    gpio_reset_pin(PIN_SWD_IO_B);
+    gpio_set_direction(PIN_SWD_IO_B, GPIO_MODE_INPUT);
+    gpio_set_pull_mode(PIN_SWD_IO_B, GPIO_PULLUP_ONLY);
+
+    gpio_reset_pin(PIN_SWD_NRST_B);
+    gpio_set_direction(PIN_SWD_NRST_B, GPIO_MODE_OUTPUT);
+    gpio_set_level(PIN_SWD_NRST_B, 1);      /* Deasserted */
+#endif
 }
 
 /* ------------------------------------------------------------------ */
@@ -189,18 +441,6 @@ static void blink_led(gpio_num_t pin, int count, int half_period_ms)
     }
 }
 
-/* ------------------------------------------------------------------ */
-/*  Debounced button read                                               */
-/* ------------------------------------------------------------------ */
-static bool start_button_pressed(void)
-{
-    if (!BUTTON_PRESSED(PIN_START_BUTTON)) {
-        return false;
-    }
-    vTaskDelay(pdMS_TO_TICKS(DEBOUNCE_MS));
-    return BUTTON_PRESSED(PIN_START_BUTTON);
-}
-
 /* ------------------------------------------------------------------ */
 /*  Force all outputs to safe state                                    */
 /* ------------------------------------------------------------------ */
@@ -208,32 +448,257 @@ static void force_safe_state(void)
 {
     gpio_set_level(PIN_SIM_START, 1);
     gpio_set_level(PIN_SIM_STOP,  1);
+#ifdef CONFIG_LATCHPAC_DUAL_DUT
+    gpio_set_level(PIN_SIM_START_B, 1);
+    gpio_set_level(PIN_SIM_STOP_B,  1);
+#endif
     leds_off();
 #ifndef MOCK_HARDWARE_MODE
     swd_safe_state();     /* v3: restore SWD GPIOs to idle on abort */
 #endif
 }
 
+/* ------------------------------------------------------------------ */
+/*  Per-fixture SWD clock setup (CONFIG_LATCHPAC_SWD_TRAIN)             */
+/*                                                                      */
+/*  First boot with a DUT in the nest trains the bit-bang half-period   */
+/*  and persists it; later boots just load the value.  Only relevant    */
+/*  when the bit-bang backend is active.                                */
+/* ------------------------------------------------------------------ */
+#if defined(CONFIG_LATCHPAC_SWD_TRAIN) && !defined(MOCK_HARDWARE_MODE)
+static void swd_clock_setup(void)
+{
+    if (swd_get_backend() != SWD_BACKEND_BITBANG) {
+        return;     /* Fast backend is NOP-paced -- nothing to train */
+    }
+
+    nvs_handle_t handle;
+    if (nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK) {
+        return;
+    }
+
+    uint32_t delay_us = 0;
+    if (nvs_get_u32(handle, NVS_KEY_SWD_DELAY, &delay_us) == ESP_OK) {
+        swd_set_delay_us(delay_us);
+        printf("INFO, SWD clock: trained half-period %lu us (from NVS)\n",
+               (unsigned long)delay_us);
+    } else if (swd_train_clock(&delay_us) == SWD_OK) {
+        nvs_set_u32(handle, NVS_KEY_SWD_DELAY, delay_us);
+        nvs_commit(handle);
+        printf("INFO, SWD clock: trained half-period %lu us persisted\n",
+               (unsigned long)delay_us);
+    }
+    nvs_close(handle);
+}
+#endif /* CONFIG_LATCHPAC_SWD_TRAIN && !MOCK_HARDWARE_MODE */
+
+/* ------------------------------------------------------------------ */
+/*  Dual-DUT: slot B test task (CONFIG_LATCHPAC_DUAL_DUT)               */
+/*                                                                      */
+/*  app_main runs slot A inline and joins slot B's report via the      */
+/*  done semaphore.  If the task cannot be created the slots run       */
+/*  sequentially -- slower, never wrong.                               */
+/* ------------------------------------------------------------------ */
+#ifdef CONFIG_LATCHPAC_DUAL_DUT
+
+static test_report_t     s_slot_b_report;
+static SemaphoreHandle_t s_slot_b_done = NULL;
+
+static void slot_b_test_task(void *arg)
+{
+    (void)arg;
+    s_slot_b_report = run_production_test_slot(&TEST_SLOT_B);
+    xSemaphoreGive(s_slot_b_done);
+    vTaskDelete(NULL);
+}
+
+static bool slot_b_test_start(void)
+{
+    if (s_slot_b_done == NULL) {
+        s_slot_b_done = xSemaphoreCreateBinary();
+    }
+    if (s_slot_b_done == NULL) {
+        return false;
+    }
+    /* Core 1 keeps the slot's interrupt-masked SWD bursts away from
+     * the UI/logging interrupt load (see CONFIG_LATCHPAC_SWD_BURST) */
+#ifdef CONFIG_LATCHPAC_SWD_BURST
+    const BaseType_t core = 1;
+#else
+    const BaseType_t core = tskNO_AFFINITY;
+#endif
+    return xTaskCreatePinnedToCore(slot_b_test_task, "slot_b_test", 6144,
+                                   NULL, uxTaskPriorityGet(NULL), NULL,
+                                   core) == pdPASS;
+}
+
+#endif /* CONFIG_LATCHPAC_DUAL_DUT */
+
 /* ------------------------------------------------------------------ */
 /*  Boot-time SWD integrity self-test                                   */
 /* ------------------------------------------------------------------ */
-static void run_boot_integrity_test(void)
+static void run_integrity_test(int iterations)
 {
     printf("INFO, Running SWD integrity self-test (%d iterations)...\n",
-           INTEGRITY_ITERATIONS);
+           iterations);
 
     int pass = 0, fail = 0;
 #ifdef MOCK_HARDWARE_MODE
-    mock_swd_integrity_test(INTEGRITY_ITERATIONS, &pass, &fail);
+    mock_swd_integrity_test(iterations, &pass, &fail);
 #else
-    swd_integrity_test(INTEGRITY_ITERATIONS, &pass, &fail);
+    swd_integrity_test(iterations, &pass, &fail);
 #endif
 
     if (fail > 0) {
         printf("INFO, WARNING: SWD integrity %d/%d passed -- check pogo contact\n",
-               pass, INTEGRITY_ITERATIONS);
+               pass, iterations);
     } else {
-        printf("INFO, SWD integrity OK: %d/%d passed\n", pass, INTEGRITY_ITERATIONS);
+        printf("INFO, SWD integrity OK: %d/%d passed\n", pass, iterations);
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/*  Boot-time SWD bring-up task                                         */
+/*                                                                      */
+/*  Clock setup + integrity self-test add up to several hundred ms of  */
+/*  pure SWD wire time (ten resync cycles, each with a 30 ms target    */
+/*  reset); running them serially after the boot blink left fixtures   */
+/*  dark for seconds after every shift-change power event.  This task  */
+/*  runs them concurrently with the blink; app_main joins on the done  */
+/*  semaphore before printing the ready banner.  NVS init stays ahead  */
+/*  of the task -- the trained-clock load reads NVS.                   */
+/* ------------------------------------------------------------------ */
+static SemaphoreHandle_t s_boot_swd_done = NULL;
+
+static void boot_swd_task(void *arg)
+{
+    (void)arg;
+#if defined(CONFIG_LATCHPAC_SWD_TRAIN) && !defined(MOCK_HARDWARE_MODE)
+    /* Per-fixture SWD clock: load trained timing, or train + persist */
+    swd_clock_setup();
+#endif
+    run_integrity_test(INTEGRITY_ITERATIONS);
+    xSemaphoreGive(s_boot_swd_done);
+    vTaskDelete(NULL);
+}
+
+static bool boot_swd_start(void)
+{
+    s_boot_swd_done = xSemaphoreCreateBinary();
+    if (s_boot_swd_done == NULL) {
+        return false;
+    }
+#ifdef CONFIG_LATCHPAC_SWD_BURST
+    const BaseType_t core = 1;      /* Same placement as all SWD work */
+#else
+    const BaseType_t core = tskNO_AFFINITY;
+#endif
+    return xTaskCreatePinnedToCore(boot_swd_task, "boot_swd", 4096,
+                                   NULL, uxTaskPriorityGet(NULL), NULL,
+                                   core) == pdPASS;
+}
+
+/* ------------------------------------------------------------------ */
+/*  Soak / burn-in mode                                                 */
+/*                                                                      */
+/*  Entered by holding START for SOAK_HOLD_MS in IDLE.  Loops the v2    */
+/*  test cycle back-to-back for SOAK_MAX_ITER iterations or             */
+/*  SOAK_MAX_MINUTES, whichever comes first, and reports pass/fail      */
+/*  counts plus min/median/p95/max cycle time.  Replaces the operator   */
+/*  pressing the button 200 times with a stopwatch when qualifying a    */
+/*  new fixture.  Soak cycles deliberately bypass the CSV result log    */
+/*  and the unit counter -- they are fixture exercise, not units.       */
+/*  A short START press or an open lid aborts early (partial stats      */
+/*  still print).  Dual-DUT fixtures soak slot A only.                  */
+/* ------------------------------------------------------------------ */
+#define SOAK_HOLD_MS        3000
+#define SOAK_MAX_ITER       200
+#define SOAK_MAX_MINUTES    10
+#define SOAK_PROGRESS_EVERY 10
+
+/* Fixed stats memory -- sorted in place for the percentile report */
+static uint32_t s_soak_cycle_ms[SOAK_MAX_ITER];
+
+static void soak_sort_cycles(int n)
+{
+    for (int i = 1; i < n; i++) {
+        uint32_t v = s_soak_cycle_ms[i];
+        int j = i - 1;
+        while (j >= 0 && s_soak_cycle_ms[j] > v) {
+            s_soak_cycle_ms[j + 1] = s_soak_cycle_ms[j];
+            j--;
+        }
+        s_soak_cycle_ms[j + 1] = v;
+    }
+}
+
+static void run_soak_mode(int max_iter)
+{
+    if (max_iter < 1 || max_iter > SOAK_MAX_ITER) {
+        max_iter = SOAK_MAX_ITER;   /* Stats memory is sized for this */
+    }
+    printf("INFO, SOAK mode -- up to %d iterations / %d minutes, short START press aborts\n",
+           max_iter, SOAK_MAX_MINUTES);
+
+    /* Wait for the operator to release the button so the hold itself
+     * doesn't read as an abort */
+    while (BUTTON_PRESSED(PIN_START_BUTTON)) {
+        vTaskDelay(pdMS_TO_TICKS(50));
+    }
+    (void)ui_wait_events(UI_EVT_START_PRESSED | UI_EVT_LID_CHANGED, 0);
+
+    int passes = 0, fails = 0, iters = 0;
+    int64_t t_soak_end = esp_timer_get_time()
+                       + (int64_t)SOAK_MAX_MINUTES * 60 * 1000000;
+
+    while (iters < max_iter && esp_timer_get_time() < t_soak_end) {
+        if (LID_IS_OPEN()) {
+            printf("INFO, SOAK aborted -- lid open\n");
+            break;
+        }
+        if (ui_wait_events(UI_EVT_START_PRESSED, 0) & UI_EVT_START_PRESSED) {
+            printf("INFO, SOAK aborted by operator\n");
+            break;
+        }
+
+        swd_clear_abort();      /* Lid just checked closed */
+        test_report_t r = run_production_test_v2();
+        s_soak_cycle_ms[iters++] = r.duration_ms;
+        if (r.result == TEST_PASS) {
+            passes++;
+        } else {
+            fails++;
+            if (r.result == FAIL_SAFETY_OPEN) {
+                printf("INFO, SOAK aborted -- lid open mid-cycle\n");
+                break;
+            }
+        }
+
+        if ((iters % SOAK_PROGRESS_EVERY) == 0) {
+            printf("INFO, SOAK progress: %d cycles, %d pass / %d fail\n",
+                   iters, passes, fails);
+        }
+    }
+
+    if (iters == 0) {
+        printf("INFO, SOAK summary: no cycles completed\n");
+        return;
+    }
+
+    soak_sort_cycles(iters);
+    printf("INFO, SOAK summary: cycles=%d pass=%d fail=%d "
+           "min=%lums median=%lums p95=%lums max=%lums\n",
+           iters, passes, fails,
+           (unsigned long)s_soak_cycle_ms[0],
+           (unsigned long)s_soak_cycle_ms[iters / 2],
+           (unsigned long)s_soak_cycle_ms[(iters * 95) / 100],
+           (unsigned long)s_soak_cycle_ms[iters - 1]);
+
+    /* Fixture verdict on the panel LED: solid green only for a clean run */
+    if (fails == 0) {
+        gpio_set_level(PIN_STATUS_LED_G, 1);
+    } else {
+        blink_led(PIN_STATUS_LED_R, FAIL_BLINK_COUNT, FAIL_BLINK_MS);
     }
 }
 
@@ -262,17 +727,61 @@ void app_main(void)
 #endif
 #endif
 
-    /* --- NVS persistent counters --- */
+    /* --- NVS persistent counters + RTC journal --- */
     nvs_init_counters();
+    esp_register_shutdown_handler(nvs_shutdown_flush);
+
+#ifdef CONFIG_LATCHPAC_RESULT_STORE
+    /* --- On-flash result ring (batched, survives power loss) --- */
+    result_store_init();
+#endif
+
+    /* --- Wi-Fi telemetry uplink (no-op unless enabled in Kconfig) --- */
+    telemetry_init();
 
     /* --- GPIO init --- */
     gpio_init_all();
 
+    /* --- Interrupt-driven operator input --- */
+    ui_input_init();
+
+    /* --- Async log channel (printf fallback until it is up) --- */
+    log_async_init();
+
+    /* --- UART command console (shares the log UART's RX side) --- */
+    console_start();
+
+#ifdef CONFIG_LATCHPAC_LOG_BINARY
+    /* Binary framed result records (decode with tools/decode_log.py) */
+    log_set_format(LOG_FORMAT_BINARY);
+#endif
+
+#ifdef CONFIG_LATCHPAC_SWD_FAST_GPIO
+    /* Fast SWD wire backend (falls back to bit-bang on init failure) */
+    swd_set_backend(SWD_BACKEND_FAST_GPIO);
+#endif
+
+#ifdef CONFIG_LATCHPAC_SWD_BURST
+    /* Jitter-free SWD transactions (critical-section bursts) */
+    swd_set_burst_mode(true);
+#endif
+
+    /* --- SWD bring-up (clock setup + integrity self-test) starts
+     * now and overlaps the boot blink below; joined before the
+     * ready banner.  On task-create failure run it inline. --- */
+    bool boot_swd_parallel = boot_swd_start();
+
     /* Boot-up indication */
     blink_led(PIN_STATUS_LED_G, BOOT_BLINK_COUNT, BOOT_BLINK_MS);
 
-    /* --- SWD integrity self-test at boot --- */
-    run_boot_integrity_test();
+    if (boot_swd_parallel) {
+        xSemaphoreTake(s_boot_swd_done, portMAX_DELAY);
+    } else {
+#if defined(CONFIG_LATCHPAC_SWD_TRAIN) && !defined(MOCK_HARDWARE_MODE)
+        swd_clock_setup();
+#endif
+        run_integrity_test(INTEGRITY_ITERATIONS);
+    }
 
     /* Print v2 CSV header */
     log_header_v2();
@@ -290,6 +799,9 @@ void app_main(void)
             .fw_version       = fw_version_str
         };
         log_result_v2(&entry);
+        result_store_append(&entry);
+        telemetry_post_result(&entry);
+        yield_stats_record(FAIL_INCOMPLETE, 0);
         printf("INFO, Logged INCOMPLETE for unit #%d (interrupted by power loss/crash)\n",
                unit_counter);
     }
@@ -321,6 +833,11 @@ void app_main(void)
                     .fw_version       = fw_version_str
                 };
                 log_result_v2(&entry);
+                result_store_append(&entry);
+                telemetry_post_result(&entry);
+                yield_stats_record(FAIL_SAFETY_OPEN, 0);
+                /* Abort is a state change: don't sit on the record */
+                result_store_flush();
                 printf("INFO, Unit %d ABORTED -- %s (lid opened mid-test)\n",
                        unit_counter, abort_str);
             }
@@ -335,11 +852,85 @@ void app_main(void)
 
         case STATE_IDLE:
             leds_off();
-            if (start_button_pressed() && LID_IS_CLOSED()) {
-                unit_counter++;
-                nvs_save_unit_counter();
-                printf("INFO, Starting test #%d\n", unit_counter);
-                state = STATE_TESTING;
+            {
+                /* Console-scripted work runs from here, like an
+                 * operator would (lid rules included).  The mailbox
+                 * is polled on the 500 ms idle heartbeat. */
+                int creq_arg = 0;
+                uint32_t creq_addr = 0;
+                console_req_t creq = console_take_request(&creq_arg, &creq_addr);
+                if (creq == CONSOLE_REQ_BATCH) {
+                    if (LID_IS_CLOSED()) {
+                        run_soak_mode(creq_arg);
+                    } else {
+                        printf("INFO, console: close the lid to run a test batch\n");
+                    }
+                    break;
+                }
+                if (creq == CONSOLE_REQ_INTEGRITY) {
+                    run_integrity_test(creq_arg);
+                    break;
+                }
+                if (creq == CONSOLE_REQ_RETRAIN) {
+#if defined(CONFIG_LATCHPAC_SWD_TRAIN) && !defined(MOCK_HARDWARE_MODE)
+                    uint32_t trained_us = 0;
+                    if (swd_train_clock(&trained_us) == SWD_OK) {
+                        nvs_handle_t handle;
+                        if (nvs_open(NVS_NAMESPACE, NVS_READWRITE, &handle) == ESP_OK) {
+                            nvs_set_u32(handle, NVS_KEY_SWD_DELAY, trained_us);
+                            nvs_commit(handle);
+                            nvs_close(handle);
+                        }
+                        printf("INFO, SWD clock: re-trained half-period %lu us persisted\n",
+                               (unsigned long)trained_us);
+                    } else {
+                        printf("INFO, SWD clock: re-training failed -- previous setting kept\n");
+                    }
+#else
+                    printf("INFO, console: clock training not available in this build\n");
+#endif
+                    break;
+                }
+                if (creq == CONSOLE_REQ_DUMP) {
+#ifndef MOCK_HARDWARE_MODE
+                    if (LID_IS_CLOSED()) {
+                        swd_clear_abort();
+                        swd_mem_dump(creq_addr, (uint32_t)creq_arg);
+                    } else {
+                        printf("INFO, console: close the lid to dump DUT memory\n");
+                    }
+#else
+                    printf("INFO, console: memory dump not available in mock mode\n");
+#endif
+                    break;
+                }
+
+                EventBits_t bits = ui_wait_events(
+                    UI_EVT_START_PRESSED | UI_EVT_LID_CHANGED, UI_IDLE_WAIT_MS);
+                if ((bits & UI_EVT_START_PRESSED) && LID_IS_CLOSED()) {
+                    /* Held START = soak mode; a short press starts one test */
+                    int held_ms = 0;
+                    while (BUTTON_PRESSED(PIN_START_BUTTON) &&
+                           held_ms < SOAK_HOLD_MS) {
+                        vTaskDelay(pdMS_TO_TICKS(DEBOUNCE_MS));
+                        held_ms += DEBOUNCE_MS;
+                    }
+                    if (held_ms >= SOAK_HOLD_MS) {
+                        run_soak_mode(SOAK_MAX_ITER);
+                        break;      /* Back to IDLE */
+                    }
+#ifdef CONFIG_LATCHPAC_DUAL_DUT
+                    unit_counter += 2;      /* One unit per slot */
+                    nvs_save_unit_counter();
+                    printf("INFO, Starting tests #%d (slot A) + #%d (slot B)\n",
+                           unit_counter - 1, unit_counter);
+#else
+                    unit_counter++;
+                    nvs_save_unit_counter();
+                    printf("INFO, Starting test #%d\n", unit_counter);
+#endif
+                    state = STATE_TESTING;
+                }
             }
             break;
 
@@ -347,15 +938,44 @@ void app_main(void)
             gpio_set_level(PIN_STATUS_LED_G, 1);
             gpio_set_level(PIN_STATUS_LED_R, 1);
 
+            /* Lid is closed (checked at START) -- drop any stale
+             * safety abort from a previous lid-open */
+            swd_clear_abort();
+
             /* v3: Mark test as active in NVS (survives power loss) */
             nvs_set_test_active(true);
 
+#ifdef CONFIG_LATCHPAC_DUAL_DUT
+            int unit_a = unit_counter - 1;
+
+            /* Slot B overlaps in its own task; slot A runs inline.
+             * If the task can't start, fall back to sequential. */
+            bool b_started = slot_b_test_start();
+            if (!b_started) {
+                printf("INFO, slot B task create failed -- running slots sequentially\n");
+            }
+            test_report_t report = run_production_test_slot(&TEST_SLOT_A);
+            test_report_t report_b;
+            if (b_started) {
+                xSemaphoreTake(s_slot_b_done, portMAX_DELAY);
+                report_b = s_slot_b_report;
+            } else {
+                report_b = run_production_test_slot(&TEST_SLOT_B);
+            }
+#else
+            int unit_a = unit_counter;
+
             /* Run v2/v3 test with full report */
             test_report_t report = run_production_test_v2();
+#endif
 
             /* Ensure pogo pins are safe */
             gpio_set_level(PIN_SIM_START, 1);
             gpio_set_level(PIN_SIM_STOP,  1);
+#ifdef CONFIG_LATCHPAC_DUAL_DUT
+            gpio_set_level(PIN_SIM_START_B, 1);
+            gpio_set_level(PIN_SIM_STOP_B,  1);
+#endif
             leds_off();
 
             const char *status_str = test_result_to_string(report.result);
@@ -369,7 +989,7 @@ void app_main(void)
 
             /* Log with v2 enhanced format */
             log_entry_t entry = {
-                .unit_id        = unit_counter,
+                .unit_id        = unit_a,
                 .status         = status_str,
                 .voltage        = voltage,
                 .swd_idcode     = report.swd_idcode,
@@ -378,19 +998,87 @@ void app_main(void)
                 .fw_version     = fw_version_str
             };
             log_result_v2(&entry);
+            result_store_append(&entry);
+            telemetry_post_result(&entry);
+            yield_stats_record(report.result, report.duration_ms);
+
+            bool all_pass = (report.result == TEST_PASS);
+
+#ifdef CONFIG_LATCHPAC_DUAL_DUT
+            const char *status_str_b = test_result_to_string(report_b.result);
+            log_entry_t entry_b = {
+                .unit_id        = unit_counter,
+                .status         = status_str_b,
+                .voltage        = gpio_get_level(PIN_LOAD_SENSE_B) ? 3.3f : 0.0f,
+                .swd_idcode     = report_b.swd_idcode,
+                .swd_attempts   = report_b.swd_attempts,
+                .test_duration_ms = report_b.duration_ms,
+                .fw_version     = fw_version_str
+            };
+            log_result_v2(&entry_b);
+            result_store_append(&entry_b);
+            telemetry_post_result(&entry_b);
+            yield_stats_record(report_b.result, report_b.duration_ms);
+            all_pass = all_pass && (report_b.result == TEST_PASS);
+#endif
 
             /* v3: Clear test-active flag -- test completed normally */
             nvs_set_test_active(false);
 
+#ifndef MOCK_HARDWARE_MODE
+            /* SWD wire health summary, reset per unit.  max_wait_depth
+             * creeping up is pogo-pin wear -- swap the pins before
+             * units start hard-failing. */
+            {
+                swd_stats_t ws;
+                swd_get_stats(&ws);
+                uint32_t waits = 0;
+                int max_depth = 0;
+                for (int i = 0; i < SWD_STATS_WAIT_DEPTH; i++) {
+                    waits += ws.wait_depth[i];
+                    if (ws.wait_depth[i] > 0) max_depth = i + 1;
+                }
+                printf("INFO, SWD wire stats: xfers=%lu pipelined=%lu waits=%lu "
+                       "max_wait_depth=%d faults=%lu parity=%lu line_resets=%lu bus=%lums\n",
+                       (unsigned long)ws.transactions,
+                       (unsigned long)ws.pipelined,
+                       (unsigned long)waits, max_depth,
+                       (unsigned long)ws.faults,
+                       (unsigned long)ws.parity_errors,
+                       (unsigned long)ws.line_resets,
+                       (unsigned long)(ws.bus_time_us / 1000));
+                swd_reset_stats();
+            }
+#endif
+
+            /* Rolling yield + Pareto -- one line per unit while the
+             * fixture is healthy, the full ranking once it is not */
+            yield_stats_print();
+
             if (report.result == TEST_PASS) {
-                gpio_set_level(PIN_STATUS_LED_G, 1);
                 printf("INFO, Unit %d PASSED (duration=%lums)\n",
-                       unit_counter, (unsigned long)report.duration_ms);
+                       unit_a, (unsigned long)report.duration_ms);
+            } else {
+                printf("INFO, Unit %d FAILED -- %s (duration=%lums)\n",
+                       unit_a, status_str, (unsigned long)report.duration_ms);
+            }
+#ifdef CONFIG_LATCHPAC_DUAL_DUT
+            if (report_b.result == TEST_PASS) {
+                printf("INFO, Unit %d PASSED (duration=%lums)\n",
+                       unit_counter, (unsigned long)report_b.duration_ms);
+            } else {
+                printf("INFO, Unit %d FAILED -- %s (duration=%lums)\n",
+                       unit_counter, status_str_b,
+                       (unsigned long)report_b.duration_ms);
+            }
+#endif
+
+            /* Panel LED shows the fixture-level verdict (all slots) */
+            if (all_pass) {
+                gpio_set_level(PIN_STATUS_LED_G, 1);
             } else {
                 blink_led(PIN_STATUS_LED_R, FAIL_BLINK_COUNT, FAIL_BLINK_MS);
                 gpio_set_level(PIN_STATUS_LED_R, 1);
-                printf("INFO, Unit %d FAILED -- %s (duration=%lums)\n",
-                       unit_counter, status_str, (unsigned long)report.duration_ms);
             }
 
             state = STATE_RESULT;
@@ -398,9 +1086,12 @@ void app_main(void)
         }
 
         case STATE_RESULT:
+            ui_wait_events(UI_EVT_LID_CHANGED, UI_IDLE_WAIT_MS);
             if (LID_IS_OPEN()) {
                 printf("INFO, Lid opened -- resetting to IDLE\n");
                 leds_off();
+                /* Operator pause: a natural point to flush the batch */
+                result_store_flush();
                 state = STATE_IDLE;
             }
             break;
@@ -412,6 +1103,7 @@ void app_main(void)
             break;
         }
 
-        vTaskDelay(pdMS_TO_TICKS(POLL_MS));
+        /* No polling delay: IDLE and RESULT block on UI events above,
+         * TESTING does real work. */
     }
 }
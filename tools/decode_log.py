@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""LatchPac Validator 3000 -- binary log decoder.
+
+Decodes the binary framed result records emitted when
+CONFIG_LATCHPAC_LOG_BINARY is set (see log_record_bin_t in
+components/result_logger/include/csv_logger.h) back into the v2 CSV
+format.  Plain ASCII INFO lines interleaved in the stream pass
+through unchanged.
+
+Usage:
+    decode_log.py capture.bin            # decode a captured file
+    cat /dev/ttyUSB0 | decode_log.py     # decode a live stream
+
+Records are located by scanning for the 0x4C 0x50 magic and verified
+with the trailing CRC-16/CCITT-FALSE; corrupted frames are skipped
+with a warning on stderr and the scan resyncs on the next magic.
+"""
+
+import struct
+import sys
+
+MAGIC = b"LP"                       # 0x504C little-endian on the wire
+
+# magic, seq, timestamp_ms, unit_id, status[20], voltage,
+# swd_idcode, swd_attempts, test_duration_ms, fw_version[16], crc
+RECORD_FMT = "<HHqi20sfIiI16sH"
+RECORD_LEN = struct.calcsize(RECORD_FMT)
+
+CSV_HEADER = ("LOG_HEADER, Timestamp_ms, Unit_ID, Status, Load_Voltage_V, "
+              "SWD_IDCODE, SWD_Attempts, Test_Duration_ms, FW_Version")
+
+
+def crc16_ccitt(data: bytes) -> int:
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def c_str(raw: bytes) -> str:
+    return raw.split(b"\0", 1)[0].decode("ascii", errors="replace")
+
+
+def decode_record(rec: bytes) -> str:
+    (_, _, timestamp_ms, unit_id, status, voltage, idcode,
+     attempts, duration_ms, fw_version, _) = struct.unpack(RECORD_FMT, rec)
+    return (f"LOG, {timestamp_ms}, {unit_id:03d}, {c_str(status)}, "
+            f"{voltage:.2f}, 0x{idcode:08X}, {attempts}, {duration_ms}, "
+            f"{c_str(fw_version)}")
+
+
+def decode_stream(data: bytes, out=sys.stdout) -> int:
+    """Decode a byte stream; returns the number of valid records."""
+    print(CSV_HEADER, file=out)
+    records = 0
+    pos = 0
+    ascii_run = bytearray()
+
+    def flush_ascii():
+        if ascii_run:
+            text = ascii_run.decode("ascii", errors="replace")
+            for line in text.splitlines():
+                if line.strip():
+                    print(line, file=out)
+            ascii_run.clear()
+
+    while pos < len(data):
+        idx = data.find(MAGIC, pos)
+        if idx < 0 or idx + RECORD_LEN > len(data):
+            ascii_run.extend(data[pos:])
+            break
+
+        rec = data[idx:idx + RECORD_LEN]
+        (crc,) = struct.unpack_from("<H", rec, RECORD_LEN - 2)
+        if crc == crc16_ccitt(rec[:-2]):
+            ascii_run.extend(data[pos:idx])
+            flush_ascii()
+            print(decode_record(rec), file=out)
+            records += 1
+            pos = idx + RECORD_LEN
+        else:
+            # False magic or corrupted frame: keep scanning
+            if data[idx + 2:idx + RECORD_LEN].find(MAGIC) < 0:
+                print(f"decode_log: bad CRC at offset {idx}, skipping frame",
+                      file=sys.stderr)
+            ascii_run.extend(data[pos:idx + 2])
+            pos = idx + 2
+
+    flush_ascii()
+    return records
+
+
+def main() -> int:
+    if len(sys.argv) > 1:
+        with open(sys.argv[1], "rb") as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+
+    records = decode_stream(data)
+    print(f"decode_log: {records} record(s) decoded", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())